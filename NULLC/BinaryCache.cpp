@@ -1,5 +1,6 @@
 #include "BinaryCache.h"
 #include "Lexer.h"
+#include "Bytecode.h"
 
 namespace BinaryCache
 {
@@ -127,6 +128,249 @@ void BinaryCache::RemoveBytecode(const char* path)
 	cache.pop_back();
 }
 
+namespace BinaryCache
+{
+	unsigned int HashContinue(unsigned int hash, unsigned int value)
+	{
+		return StringHashContinue(hash, (const char*)&value, (const char*)&value + sizeof(value));
+	}
+
+	unsigned int HashContinueName(unsigned int hash, const char* &name)
+	{
+		unsigned int length = (unsigned int)strlen(name) + 1;
+		hash = StringHashContinue(hash, name, name + length);
+		name += length;
+		return hash;
+	}
+
+	const char* GetModuleName(const char* path)
+	{
+		// Modules built from files are stored with the import path, but are listed without it in the dependency lists
+		if(importPath && strncmp(path, importPath, strlen(importPath)) == 0)
+			return path + strlen(importPath);
+		return path;
+	}
+
+	bool ImportsModule(const char* bytecode, unsigned int nameHash)
+	{
+		ByteCode *code = (ByteCode*)bytecode;
+
+		ExternModuleInfo *mInfo = FindFirstModule(code);
+		for(unsigned int i = 0; i < code->dependsCount; i++)
+		{
+			if(GetStringHash(FindSymbols(code) + mInfo[i].nameOffset) == nameHash)
+				return true;
+		}
+		return false;
+	}
+}
+
+unsigned int BinaryCache::GetInterfaceHash(const char* bytecode)
+{
+	ByteCode *code = (ByteCode*)bytecode;
+	char *symbols = FindSymbols(code);
+
+	unsigned int hash = GetStringHash("");
+	bool hasGenerics = false;
+
+	hash = HashContinue(hash, code->globalVarSize);
+
+	ExternModuleInfo *mInfo = FindFirstModule(code);
+	for(unsigned int i = 0; i < code->dependsCount; i++)
+	{
+		const char *name = symbols + mInfo[i].nameOffset;
+		hash = HashContinueName(hash, name);
+	}
+
+	ExternTypeInfo *tInfo = FindFirstType(code);
+	ExternMemberInfo *memberList = FindFirstMember(code);
+	for(unsigned int i = 0; i < code->typeCount; i++)
+	{
+		ExternTypeInfo &type = tInfo[i];
+
+		// Member and constant names follow the type name
+		const char *name = symbols + type.offsetToName;
+		hash = HashContinueName(hash, name);
+		if(type.subCat == ExternTypeInfo::CAT_CLASS)
+		{
+			for(unsigned int k = 0; k < type.memberCount + type.constantCount; k++)
+				hash = HashContinueName(hash, name);
+		}
+
+		hash = HashContinue(hash, type.size);
+		hash = HashContinue(hash, type.padding);
+		hash = HashContinue(hash, type.type);
+		hash = HashContinue(hash, type.subCat);
+		hash = HashContinue(hash, type.defaultAlign | (type.typeFlags << 8) | (type.pointerCount << 16));
+		hash = HashContinue(hash, type.arrSize);
+		hash = HashContinue(hash, type.constantCount);
+		hash = HashContinue(hash, type.namespaceHash);
+		hash = HashContinue(hash, type.definitionOffset);
+		hash = HashContinue(hash, type.genericTypeCount);
+		hash = HashContinue(hash, type.baseType);
+
+		unsigned int memberCount = 0;
+		if(type.subCat == ExternTypeInfo::CAT_FUNCTION)
+			memberCount = type.memberCount + 1;
+		else if(type.subCat == ExternTypeInfo::CAT_CLASS)
+			memberCount = type.memberCount + type.pointerCount;
+		else
+			hash = HashContinue(hash, type.subType);
+
+		for(unsigned int k = 0; k < memberCount; k++)
+		{
+			hash = HashContinue(hash, memberList[type.memberOffset + k].type);
+			hash = HashContinue(hash, memberList[type.memberOffset + k].offset);
+		}
+
+		if(type.definitionOffset != ~0u && !(type.definitionOffset & 0x80000000))
+			hasGenerics = true;
+	}
+
+	ExternConstantInfo *constantList = FindFirstConstant(code);
+	for(unsigned int i = 0; i < code->typeCount; i++)
+	{
+		for(unsigned int k = 0; k < tInfo[i].constantCount; k++, constantList++)
+		{
+			hash = HashContinue(hash, constantList->type);
+			hash = HashContinue(hash, (unsigned int)constantList->value);
+
+			// Upper part of the value is not initialized for constants of smaller types
+			if(tInfo[constantList->type].size > 4)
+				hash = HashContinue(hash, (unsigned int)(constantList->value >> 32));
+		}
+	}
+
+	ExternVarInfo *vInfo = FindFirstVar(code);
+	for(unsigned int i = 0; i < code->variableCount; i++)
+	{
+		const char *name = symbols + vInfo[i].offsetToName;
+		hash = HashContinueName(hash, name);
+		hash = HashContinue(hash, vInfo[i].type);
+		hash = HashContinue(hash, vInfo[i].offset);
+	}
+
+	// Functions of imported modules are not included in the bytecode
+	ExternFuncInfo *fInfo = FindFirstFunc(code);
+	ExternLocalInfo *localInfo = FindFirstLocal(code);
+	for(unsigned int i = 0; i < code->functionCount - code->moduleFunctionCount; i++)
+	{
+		ExternFuncInfo &func = fInfo[i];
+
+		// Function address and code size are not included, code that imports the module is linked to the new function code
+		hash = HashContinue(hash, func.nameHash);
+		hash = HashContinue(hash, func.namespaceHash);
+		hash = HashContinue(hash, func.isVisible);
+		hash = HashContinue(hash, func.retType | (func.funcCat << 8) | (func.isGenericInstance << 16) | (func.returnShift << 24));
+		hash = HashContinue(hash, func.funcType);
+		hash = HashContinue(hash, func.parentType);
+		hash = HashContinue(hash, func.contextType);
+		hash = HashContinue(hash, func.paramCount);
+		hash = HashContinue(hash, func.bytesToPop);
+		hash = HashContinue(hash, func.genericOffset);
+		hash = HashContinue(hash, func.genericReturnType);
+		hash = HashContinue(hash, func.explicitTypeCount);
+
+		// Parameter names, types and default values are used by function calls
+		for(unsigned int k = 0; k < func.paramCount; k++)
+		{
+			ExternLocalInfo &local = localInfo[func.offsetToFirstLocal + k];
+
+			const char *name = symbols + local.offsetToName;
+			hash = HashContinueName(hash, name);
+			hash = HashContinue(hash, local.paramType | (local.paramFlags << 8) | (local.defaultFuncId << 16));
+			hash = HashContinue(hash, local.type);
+			hash = HashContinue(hash, local.size);
+			hash = HashContinue(hash, local.offset);
+		}
+
+		// Generic functions have no type
+		if(func.address == -1 && func.funcType == 0)
+			hasGenerics = true;
+	}
+
+	ExternTypedefInfo *typedefList = FindFirstTypedef(code);
+	for(unsigned int i = 0; i < code->typedefCount; i++)
+	{
+		const char *name = symbols + typedefList[i].offsetToName;
+		hash = HashContinueName(hash, name);
+		hash = HashContinue(hash, typedefList[i].targetType);
+		hash = HashContinue(hash, typedefList[i].parentType);
+	}
+
+	ExternNamespaceInfo *namespaceList = FindFirstNamespace(code);
+	for(unsigned int i = 0; i < code->namespaceCount; i++)
+	{
+		const char *name = symbols + namespaceList[i].offsetToName;
+		hash = HashContinueName(hash, name);
+		hash = HashContinue(hash, namespaceList[i].parentHash);
+	}
+
+	// Generic functions and types are instanced from the module source in the modules that import it
+	if(hasGenerics)
+		hash = StringHashContinue(hash, FindSource(code), FindSource(code) + code->sourceSize);
+
+	return hash;
+}
+
+unsigned int BinaryCache::RemoveDependentModules(const char* path, FastVector<CodeDescriptor> *removed)
+{
+	FastVector<unsigned int> pending;
+	pending.push_back(GetStringHash(GetModuleName(path)));
+
+	unsigned int affected = 0;
+	for(unsigned int n = 0; n < pending.size(); n++)
+	{
+		for(unsigned int i = 0; i < cache.size(); i++)
+		{
+			if(!ImportsModule(cache[i].binary, pending[n]))
+				continue;
+
+			unsigned int nameHash = GetStringHash(GetModuleName(cache[i].name));
+			bool known = false;
+			for(unsigned int k = 0; k < pending.size() && !known; k++)
+				known = pending[k] == nameHash;
+			if(known)
+				continue;
+			pending.push_back(nameHash);
+			affected++;
+
+			// Lexemes of a module include the lexemes of the modules it imports
+			delete[] cache[i].lexemes;
+			cache[i].lexemes = NULL;
+			cache[i].lexemeCount = 0;
+
+			if(removed)
+			{
+				removed->push_back(cache[i]);
+
+				cache[i] = cache.back();
+				cache.pop_back();
+				i--;
+			}
+		}
+	}
+
+	// Every module is placed after the removed modules it imports
+	for(unsigned int i = 0; removed && i < removed->size(); i++)
+	{
+		for(unsigned int k = i; k < removed->size(); k++)
+		{
+			bool ready = true;
+			for(unsigned int j = i; j < removed->size() && ready; j++)
+				ready = !ImportsModule((*removed)[k].binary, GetStringHash(GetModuleName((*removed)[j].name)));
+			if(!ready)
+				continue;
+
+			CodeDescriptor tmp = (*removed)[i];
+			(*removed)[i] = (*removed)[k];
+			(*removed)[k] = tmp;
+			break;
+		}
+	}
+	return affected;
+}
+
 const char* BinaryCache::EnumerateModules(unsigned id)
 {
 	if(id >= cache.size())
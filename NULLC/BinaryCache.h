@@ -14,11 +14,6 @@ namespace BinaryCache
 	void		RemoveBytecode(const char* path);
 	const char*	EnumerateModules(unsigned id);
 
-	void		LastBytecode(const char* bytecode);
-
-	void		SetImportPath(const char* path);
-	const char*	GetImportPath();
-
 	struct	CodeDescriptor
 	{
 		const char		*name;
@@ -27,4 +22,17 @@ namespace BinaryCache
 		Lexeme			*lexemes;
 		unsigned		lexemeCount;
 	};
+
+	// Hash of everything that a module importing the bytecode depends on: types, global variables, function signatures and generic definitions
+	unsigned int	GetInterfaceHash(const char* bytecode);
+
+	// Removes cached lexemes of modules that import the module, directly or through other modules. If 'removed' is set, their entries are also moved out of the cache into it,
+	// ordered so that every module follows the modules it imports. Names and binaries of the moved entries are released by the caller
+	// Function returns the number of modules that were affected
+	unsigned int	RemoveDependentModules(const char* path, FastVector<CodeDescriptor> *removed);
+
+	void		LastBytecode(const char* bytecode);
+
+	void		SetImportPath(const char* path);
+	const char*	GetImportPath();
 }
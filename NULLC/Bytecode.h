@@ -155,6 +155,9 @@ struct ExternFuncInfo
 	unsigned int	explicitTypeCount;
 
 	unsigned int	nameHash;
+
+	// Calls to the function were replaced with its body, so it can't be overridden at run time
+	unsigned int	isInlined;
 };
 
 struct ExternTypedefInfo
@@ -24,6 +24,24 @@ char			*errorReport = NULL;
 // Number of implicit variable
 unsigned int inplaceVariableNum;
 
+// Maximum number of nodes in an expression that replaces a function call
+unsigned int inlineNodeLimit = NULLC_DEFAULT_INLINE_LIMIT;
+// Inlining is disabled when functions can be overridden at run time
+bool inlineEnabled;
+// Calls to pure functions are reused or removed by the optimizer only when functions can't be replaced at run time
+bool pureCallsEnabled;
+// Number of hidden variables that hold arguments of inlined functions
+unsigned int inlineFrameNum;
+// Number of hidden variables that hold values hoisted out of loop conditions or reused in an expression
+unsigned int optimizerTemporaryNum;
+
+// Stack memory and the number of calls and loop iterations available to compile-time evaluation of a pure function call
+unsigned int evaluationMemoryLimit = NULLC_DEFAULT_EVALUATION_MEMORY;
+unsigned int evaluationStepLimit = NULLC_DEFAULT_EVALUATION_STEPS;
+FastVector<char> evaluationMemory;
+// Number of pure function calls that were replaced with their result, calls that couldn't be evaluated and the total number of evaluation steps
+unsigned int evaluatedCallCount, failedCallCount, evaluationStepCount;
+
 FunctionInfo	*uncalledFunc = NULL;
 const char		*uncalledPos = NULL;
 
@@ -44,6 +62,10 @@ FastVector<unsigned int>	funcInfoTop;
 // Cycle depth stack is used to determine what is the depth of the loop when compiling operators break and continue
 FastVector<unsigned int>	cycleDepth;
 
+// Stack of for each iterators, holds array indexing node for iteration over built-in array or NULL for other iterators
+// Element index in a loop with a single built-in array iterator is checked by the loop condition right before indexing, so bounds check can be removed
+FastVector<NodeArrayIndex*>	forEachIndex;
+
 // Stack of functions that are being defined at the moment
 FastVector<FunctionInfo*>	currDefinedFunc;
 // A list of generic function instances that should be created in the right scope
@@ -52,6 +74,9 @@ FastVector<FunctionInfo*>	delayedInstance;
 HashMap<FunctionInfo*>		funcMap;
 HashMap<VariableInfo*>		varMap;
 
+// Incremented when a function is added or a class changes to invalidate cached overload selections that involve generic functions
+unsigned int	overloadCacheGeneration;
+
 unsigned	extendableVariableName = GetStringHash("$typeid");
 
 unsigned GetFunctionHiddenName(char* buf, FunctionInfo &info)
@@ -63,6 +88,8 @@ unsigned GetFunctionHiddenName(char* buf, FunctionInfo &info)
 void	AddFunctionToSortedList(FunctionInfo *info)
 {
 	funcMap.insert(info->nameHash, info);
+
+	overloadCacheGeneration++;
 }
 
 const char*	currFunction = NULL;
@@ -264,6 +291,21 @@ FastVector<unsigned int>	bestFuncRating;
 FastVector<FunctionInfo*>	bestFuncListBackup;
 FastVector<unsigned int>	bestFuncRatingBackup;
 
+// Overload selection cache. Key is the parent type followed by the list of candidate functions and argument types
+struct OverloadCacheEntry
+{
+	unsigned int	keyStart, keyLength;
+	unsigned int	index, rating;
+	// Generic function rating instances function header, which may depend on functions and types defined later, so such entries are valid only for a single generation
+	bool			generic;
+	unsigned int	generation;
+};
+HashMap<unsigned int>			overloadCache;
+FastVector<OverloadCacheEntry>	overloadCacheEntries;
+FastVector<void*>				overloadCacheKeys;
+FastVector<void*>				overloadKey;
+unsigned int	overloadCacheHits, overloadCacheMisses;
+
 FastVector<NamespaceInfo*>	namespaceBackup;
 
 FastVector<NodeZeroOP*>		nodeBackup;
@@ -2490,6 +2532,121 @@ void AddInplaceVariable(const char* pos, TypeInfo* targetType)
 	currType = saveCurrType;
 }
 
+// Create hidden variables with the same layout as the stack frame of an inlined function, so that the function arguments could be placed in them
+void AddInlineFrame(const char* pos, FunctionInfo* fInfo)
+{
+	// Coroutine locals are stored in a closure and hidden variables in a type definition will not be local to the function that will execute the call
+	if(currDefinedFunc.size() ? currDefinedFunc.back()->type == FunctionInfo::COROUTINE : newType != NULL)
+		return;
+
+	for(VariableInfo *curr = fInfo->firstParam; curr; curr = curr->next)
+	{
+		if(curr->varType->hasFinalizer)
+			return;
+	}
+
+	// Save variable creation state
+	TypeInfo *saveCurrType = currType;
+	bool saveVarDefined = varDefined;
+	unsigned int saveAlign = currAlign;
+
+	// Arguments are placed in stack frame without any additional alignment
+	currAlign = 4;
+
+	VariableInfo *frameStart = NULL;
+	bool sameLayout = true;
+	for(VariableInfo *curr = fInfo->firstParam; sameLayout; curr = curr->next)
+	{
+		VariableInfo *param = curr ? curr : fInfo->extraParam;
+
+		char	*varName = AllocateString(16);
+		int length = sprintf(varName, "$temparg%d", inlineFrameNum++);
+
+		// Small arguments take 4 bytes and context of a function that is not a member function is always a null pointer
+		if(param->varType->size < 4)
+			currType = typeInt;
+		else if(!curr && fInfo->type != FunctionInfo::THISCALL)
+			currType = NULLC_PTR_SIZE == 8 ? typeLong : typeInt;
+		else
+			currType = param->varType;
+
+		VariableInfo *varInfo = AddVariable(pos, InplaceStr(varName, length));
+		if(!frameStart)
+			frameStart = varInfo;
+
+		sameLayout = int(varInfo->pos - frameStart->pos) == int(param->pos) - int(fInfo->firstParam ? fInfo->firstParam->pos : fInfo->extraParam->pos);
+
+		if(!curr)
+			break;
+	}
+
+	// Restore variable creation state
+	varDefined = saveVarDefined;
+	currType = saveCurrType;
+	currAlign = saveAlign;
+
+	if(sameLayout)
+		static_cast<NodeFuncCall*>(CodeInfo::nodeList.back())->SetInlineFrame(int(frameStart->pos) - int(fInfo->firstParam ? fInfo->firstParam->pos : fInfo->extraParam->pos), frameStart->isGlobal);
+}
+
+void SetInlineNodeLimit(unsigned int limit)
+{
+	inlineNodeLimit = limit;
+}
+
+void SetInlineEnabled(bool enabled)
+{
+	inlineEnabled = enabled;
+}
+
+void SetPureCallsEnabled(bool enabled)
+{
+	pureCallsEnabled = enabled;
+}
+
+void SetEvaluationLimits(unsigned int memorySize, unsigned int stepCount)
+{
+	evaluationMemoryLimit = memorySize;
+	evaluationStepLimit = stepCount;
+}
+
+void GetEvaluationStatistics(unsigned int *evaluatedCalls, unsigned int *failedCalls, unsigned int *stepCount)
+{
+	*evaluatedCalls = evaluatedCallCount;
+	*failedCalls = failedCallCount;
+	*stepCount = evaluationStepCount;
+}
+
+VariableInfo* AddOptimizerTemporary(TypeInfo *type)
+{
+	// Save variable creation state
+	TypeInfo *saveCurrType = currType;
+	bool saveVarDefined = varDefined;
+	unsigned int saveAlign = currAlign;
+
+	currType = type;
+	currAlign = TypeInfo::ALIGNMENT_UNSPECIFIED;
+
+	char	*varName = AllocateString(24);
+	int length = sprintf(varName, "$tempopt%d", optimizerTemporaryNum++);
+
+	VariableInfo *varInfo = AddVariable(CodeInfo::lastKnownStartPos, InplaceStr(varName, length));
+
+	// Restore variable creation state
+	varDefined = saveVarDefined;
+	currType = saveCurrType;
+	currAlign = saveAlign;
+
+	return varInfo;
+}
+
+void OptimizeGlobalCode()
+{
+#if defined(NULLC_COMMON_SUBEXPRESSION_ELIMINATION) && !defined(NULLC_ENABLE_C_TRANSLATION) && !defined(NULLC_LLVM_SUPPORT)
+	TreeOptimizer::EliminateCommonSubexpressions(CodeInfo::nodeList.back(), AddOptimizerTemporary, pureCallsEnabled);
+#endif
+}
+
 void AddInplaceHeapVariable(const char* pos)
 {
 	NodeZeroOP *value = CodeInfo::nodeList.back();
@@ -3076,6 +3233,8 @@ void AddArrayIterator(const char* pos, InplaceStr varName, TypeInfo* type, bool
 		CodeInfo::nodeList.push_back(wrap2);
 		AddUnaryModifyOpNode(pos, OP_INCREMENT, OP_POSTFIX);
 		AddArrayIndexNode(pos);
+		// Array type could have an overloaded index operator
+		forEachIndex.push_back(CodeInfo::nodeList.back()->nodeType == typeNodeArrayIndex ? (NodeArrayIndex*)CodeInfo::nodeList.back() : NULL);
 		currType = (TypeInfo*)type ? CodeInfo::GetReferenceType((TypeInfo*)type) : NULL;
 		VariableInfo *it = (VariableInfo*)AddVariable(pos, varName);
 		AddDefineVariableNode(pos, it);
@@ -3147,6 +3306,7 @@ void AddArrayIterator(const char* pos, InplaceStr varName, TypeInfo* type, bool
 		// Iteration part is empty
 		AddVoidNode();
 
+		forEachIndex.push_back(NULL);
 		return;
 	}
 
@@ -3196,6 +3356,8 @@ void AddArrayIterator(const char* pos, InplaceStr varName, TypeInfo* type, bool
 	AddPopNode(pos);
 
 	it->autoDeref = true;
+
+	forEachIndex.push_back(NULL);
 }
 
 void MergeArrayIterators()
@@ -3221,10 +3383,19 @@ void MergeArrayIterators()
 	CodeInfo::nodeList.push_back(firstIter);
 	CodeInfo::nodeList.push_back(lastIter);
 	AddTwoExpressionNode(NULL);
+
+	// Conditions and iteration parts of other iterators are executed between the condition and the indexing
+	forEachIndex.pop_back();
+	forEachIndex.back() = NULL;
 }
 
 void AddForEachNode(const char* pos)
 {
+	assert(forEachIndex.size() != 0);
+	if(NodeArrayIndex *index = forEachIndex.back())
+		index->uncheckedIndex = true;
+	forEachIndex.pop_back();
+
 	// Unite increment_part and body
 	AddTwoExpressionNode(NULL);
 	// Generate while cycle
@@ -3823,6 +3994,25 @@ void FunctionEnd(const char* pos)
 
 	assert(cycleDepth.back() == 0);
 	cycleDepth.pop_back();
+
+#if defined(NULLC_DEAD_CODE_ELIMINATION) && !defined(NULLC_ENABLE_C_TRANSLATION) && !defined(NULLC_LLVM_SUPPORT)
+	TreeOptimizer::RemoveDeadCode(&lastFunc, CodeInfo::nodeList.back(), pureCallsEnabled);
+#endif
+	// Hidden variables created by optimizations must be created before the list of locals is saved
+#if defined(NULLC_ESCAPE_ANALYSIS) && !defined(NULLC_ENABLE_C_TRANSLATION) && !defined(NULLC_LLVM_SUPPORT)
+	TreeOptimizer::AllocateOnStack(&lastFunc, CodeInfo::nodeList.back(), AddOptimizerTemporary);
+#endif
+	// Loop conditions are matched before invariant parts are hoisted from them
+#if !defined(NULLC_ENABLE_C_TRANSLATION) && !defined(NULLC_LLVM_SUPPORT)
+	TreeOptimizer::RemoveBoundsChecks(&lastFunc, CodeInfo::nodeList.back(), pureCallsEnabled);
+#endif
+#if defined(NULLC_LOOP_INVARIANT_MOTION) && !defined(NULLC_ENABLE_C_TRANSLATION) && !defined(NULLC_LLVM_SUPPORT)
+	TreeOptimizer::HoistLoopInvariants(&lastFunc, CodeInfo::nodeList.back(), AddOptimizerTemporary, pureCallsEnabled);
+#endif
+#if defined(NULLC_COMMON_SUBEXPRESSION_ELIMINATION) && !defined(NULLC_ENABLE_C_TRANSLATION) && !defined(NULLC_LLVM_SUPPORT)
+	TreeOptimizer::EliminateCommonSubexpressions(CodeInfo::nodeList.back(), AddOptimizerTemporary, pureCallsEnabled);
+#endif
+
 	// Save info about all local variables
 	for(int i = CodeInfo::varInfo.size()-1; i > (int)(varInfoTop.back().activeVarCnt + lastFunc.paramCount); i--)
 	{
@@ -3884,9 +4074,19 @@ void FunctionEnd(const char* pos)
 	funcNode->SetCodeInfo(pos);
 	CodeInfo::funcDefList.push_back(funcNode);
 
+#ifdef NULLC_INLINE_FUNCTIONS
+	if(inlineEnabled && inlineNodeLimit)
+		lastFunc.inlineNode = NodeFuncCall::GetInlineReturn(&lastFunc, static_cast<NodeFuncDef*>(funcNode)->GetFirstNode(), inlineNodeLimit);
+#endif
+
 	if(lastFunc.retType->type == TypeInfo::TYPE_COMPLEX || lastFunc.retType->refLevel)
 		lastFunc.pure = false;	// Pure functions return value must be simple type
 
+#if defined(NULLC_DEAD_CODE_ELIMINATION) && !defined(NULLC_ENABLE_C_TRANSLATION) && !defined(NULLC_LLVM_SUPPORT)
+	if(lastFunc.pure)
+		lastFunc.trapFree = TreeOptimizer::IsTrapFree(static_cast<NodeFuncDef*>(funcNode)->GetFirstNode());
+#endif
+
 	// If function is local, create function parameters block
 	if((lastFunc.type == FunctionInfo::LOCAL || lastFunc.type == FunctionInfo::COROUTINE) && lastFunc.externalCount != 0)
 	{
@@ -4685,8 +4885,75 @@ bool	ShuffleArgumentsForNamedFunctionCall(unsigned argumentCount, FunctionInfo*
 	return okByNamedArgs;
 }
 
+// Fills overloadKey for current overload selection and returns false if selection result depends on more than argument types
+bool BuildOverloadKey(unsigned count, unsigned callArgCount, TypeInfo* forcedParentType, bool &generic)
+{
+	if(currExplicitTypes || IsNamedFunctionCall(callArgCount))
+		return false;
+
+	generic = false;
+
+	overloadKey.clear();
+	overloadKey.push_back(forcedParentType);
+	for(unsigned int k = 0; k < count; k++)
+	{
+		generic |= !!bestFuncList[k]->generic;
+		overloadKey.push_back(bestFuncList[k]);
+	}
+	for(unsigned int i = CodeInfo::nodeList.size() - callArgCount; i < CodeInfo::nodeList.size(); i++)
+	{
+		NodeZeroOP *arg = CodeInfo::nodeList[i];
+
+		// Function arguments and nullptr are rated by node
+		if(arg->typeInfo->funcType || arg->nodeType == typeNodeFuncDef || arg->nodeType == typeNodeFunctionProxy || (arg->nodeType == typeNodeNumber && arg->typeInfo == typeVoid->refType))
+			return false;
+		if(arg->nodeType == typeNodeExpressionList && ((NodeExpressionList*)arg)->GetFirstNode()->nodeType == typeNodeFunctionProxy)
+			return false;
+		overloadKey.push_back(arg->typeInfo);
+	}
+	return true;
+}
+
+OverloadCacheEntry* FindOverloadCacheEntry(unsigned hash)
+{
+	for(HashMap<unsigned int>::Node *curr = overloadCache.first(hash); curr; curr = overloadCache.next(curr))
+	{
+		OverloadCacheEntry &entry = overloadCacheEntries[curr->value];
+		if(entry.keyLength == overloadKey.size() && memcmp(&overloadCacheKeys[entry.keyStart], overloadKey.data, overloadKey.size() * sizeof(void*)) == 0)
+			return &entry;
+	}
+	return NULL;
+}
+
+void SetOverloadCacheEntry(OverloadCacheEntry *entry, unsigned hash, unsigned index, unsigned rating, bool generic)
+{
+	if(!entry)
+	{
+		overloadCache.insert(hash, overloadCacheEntries.size());
+		overloadCacheEntries.push_back(OverloadCacheEntry());
+
+		entry = &overloadCacheEntries.back();
+		entry->keyStart = overloadCacheKeys.size();
+		entry->keyLength = overloadKey.size();
+
+		overloadCacheKeys.push_back(overloadKey.data, overloadKey.size());
+	}
+	entry->index = index;
+	entry->rating = rating;
+	entry->generic = generic;
+	entry->generation = overloadCacheGeneration;
+}
+
+void GetOverloadCacheStatistics(unsigned int *hits, unsigned int *misses)
+{
+	*hits = overloadCacheHits;
+	*misses = overloadCacheMisses;
+}
+
 unsigned SelectBestFunction(unsigned count, unsigned callArgCount, unsigned int &minRating, TypeInfo* forcedParentType, bool hideGenerics)
 {
+	CodeInfo::compileStatistics.overloadResolutions++;
+
 	// Find the best suited function
 	bestFuncRating.resize(count);
 
@@ -5157,6 +5424,10 @@ NodeZeroOP* CreateGenericFunctionInstance(const char* pos, FunctionInfo* fInfo,
 {
 	if(instanceDepth++ > NULLC_MAX_GENERIC_INSTANCE_DEPTH)
 		ThrowError(pos, "ERROR: reached maximum generic function instance depth (%d)", NULLC_MAX_GENERIC_INSTANCE_DEPTH);
+
+	unsigned lastPhase = CodeInfo::SetCompilePhase(NULLC_PHASE_GENERICS);
+	CodeInfo::compileStatistics.genericFunctionInstances++;
+
 	// Get ID of the function that will be created
 	unsigned funcID = CodeInfo::funcInfo.size();
 
@@ -5340,6 +5611,7 @@ NodeZeroOP* CreateGenericFunctionInstance(const char* pos, FunctionInfo* fInfo,
 		*errPos++ = 0;
 
 		CodeInfo::lastError = CompilerError(errorReport, pos);
+		CodeInfo::SetCompilePhase(lastPhase);
 		longjmp(CodeInfo::errorHandler, 1);
 	}
 
@@ -5382,6 +5654,8 @@ NodeZeroOP* CreateGenericFunctionInstance(const char* pos, FunctionInfo* fInfo,
 	// Restore old namespace stack
 	RestoreNamespaces(true, fInfo->parentNamespace, prevBackupSize, prevStackSize, lastNS);
 
+	CodeInfo::SetCompilePhase(lastPhase);
+
 	instanceDepth--;
 	return funcDefAtEnd;
 }
@@ -5546,7 +5820,45 @@ bool AddFunctionCallNode(const char* pos, const char* funcName, unsigned int cal
 	// If there is a name and it's not a variable that holds 
 	if(!vInfo && funcName)
 	{
-		unsigned minRatingIndex = SelectBestFunction(count, callArgCount, minRating, forcedParentType);
+		unsigned minRatingIndex = ~0u;
+
+		// Selection that depends only on candidate list and argument types is cached
+		bool generic = false;
+		bool cacheable = BuildOverloadKey(count, callArgCount, forcedParentType, generic);
+		unsigned keyHash = cacheable ? GetStringHash((char*)overloadKey.data, (char*)(overloadKey.data + overloadKey.size())) : 0;
+		OverloadCacheEntry *cached = cacheable ? FindOverloadCacheEntry(keyHash) : NULL;
+		bool valid = cached && (!cached->generic || cached->generation == overloadCacheGeneration);
+
+		// Failed selection is performed again to report an error
+		if(valid && (cached->index != ~0u || silent))
+		{
+			overloadCacheHits++;
+
+			minRatingIndex = cached->index;
+			minRating = cached->rating;
+
+			bestFuncRating.resize(count);
+			for(unsigned int k = 0; k < count; k++)
+				bestFuncRating[k] = k == minRatingIndex ? minRating : ~0u;
+		}else{
+			minRatingIndex = SelectBestFunction(count, callArgCount, minRating, forcedParentType);
+
+			if(cacheable && !valid)
+			{
+				overloadCacheMisses++;
+
+				// Ambiguous selection is an error, so there is no need to cache it
+				bool ambiguous = false;
+				for(unsigned int k = 0; k < count && minRatingIndex != ~0u; k++)
+					ambiguous |= k != minRatingIndex && bestFuncRating[k] == minRating;
+				if(!ambiguous)
+				{
+					// Overload selection could have been used recursively during generic function rating
+					BuildOverloadKey(count, callArgCount, forcedParentType, generic);
+					SetOverloadCacheEntry(FindOverloadCacheEntry(keyHash), keyHash, minRatingIndex, minRating, generic);
+				}
+			}
+		}
 
 		// Maybe the function we found can't be used at all
 		if(minRatingIndex == ~0u)
@@ -5814,18 +6126,31 @@ bool AddFunctionCallNode(const char* pos, const char* funcName, unsigned int cal
 
 		if(!isBeingDefined)
 		{
-			static char memory[1024];
+			if(evaluationMemory.size() != evaluationMemoryLimit)
+			{
+				evaluationMemory.reset();
+				evaluationMemory.resize(evaluationMemoryLimit);
+			}
 
-			NodeFuncCall::callCount = 0;
+			NodeFuncCall::stepCount = 0;
+			NodeFuncCall::stepLimit = evaluationStepLimit;
 			NodeFuncCall::baseShift = 0;
 
-			if(NodeNumber *value = CodeInfo::nodeList.back()->Evaluate(memory, 1024))
+			NodeNumber *value = evaluationMemoryLimit ? CodeInfo::nodeList.back()->Evaluate(evaluationMemory.data, evaluationMemoryLimit) : NULL;
+
+			evaluationStepCount += NodeFuncCall::stepCount;
+
+			if(value)
 			{
+				evaluatedCallCount++;
+
 				if(value->typeInfo == typeVoid)
 					CodeInfo::nodeList.back() = new NodeZeroOP();
 				else
 					CodeInfo::nodeList.back() = value;
 			}else{
+				failedCallCount++;
+
 				if(!uncalledFunc)
 				{
 					uncalledFunc = fInfo;
@@ -5842,6 +6167,11 @@ bool AddFunctionCallNode(const char* pos, const char* funcName, unsigned int cal
 	}
 #endif
 
+#ifdef NULLC_INLINE_FUNCTIONS
+	if(fInfo && fInfo->inlineNode && CodeInfo::nodeList.back()->nodeType == typeNodeFuncCall)
+		AddInlineFrame(pos, fInfo);
+#endif
+
 	if(funcDefAtEnd)
 	{
 		CodeInfo::nodeList.push_back(funcDefAtEnd);
@@ -5966,6 +6296,15 @@ void IncreaseCycleDepth()
 	cycleDepth.back()++;
 }
 
+bool IsKnownFalse(NodeZeroOP* condition)
+{
+	if(condition->nodeType != typeNodeNumber)
+		return false;
+	if(condition->typeInfo == typeLong)
+		return static_cast<NodeNumber*>(condition)->GetLong() == 0;
+	return static_cast<NodeNumber*>(condition)->GetInteger() == 0;
+}
+
 void AddForNode(const char* pos)
 {
 	CodeInfo::lastKnownStartPos = pos;
@@ -5976,6 +6315,16 @@ void AddForNode(const char* pos)
 
 	PromoteToBool(pos);
 
+	// If condition is known to be false, only initialization is executed
+	if(IsKnownFalse(CodeInfo::nodeList.back()))
+	{
+		CodeInfo::nodeList.pop_back();
+
+		assert(cycleDepth.size() != 0);
+		cycleDepth.back()--;
+		return;
+	}
+
 	CodeInfo::nodeList.push_back(increment);
 	CodeInfo::nodeList.push_back(body);
 
@@ -5994,6 +6343,16 @@ void AddWhileNode(const char* pos)
 
 	PromoteToBool(pos);
 
+	// If condition is known to be false, loop is never executed
+	if(IsKnownFalse(CodeInfo::nodeList.back()))
+	{
+		CodeInfo::nodeList.back() = new NodeZeroOP();
+
+		assert(cycleDepth.size() != 0);
+		cycleDepth.back()--;
+		return;
+	}
+
 	CodeInfo::nodeList.push_back(body);
 
 	CodeInfo::nodeList.push_back(new NodeWhileExpr());
@@ -6141,6 +6500,8 @@ TypeInfo* TypeBegin(const char* pos, const char* end, bool addNamespace, unsigne
 // Add class member
 void TypeAddMember(const char* pos, const char* varName)
 {
+	overloadCacheGeneration++;
+
 	if(!currType)
 		ThrowError(pos, "ERROR: auto cannot be used for class members");
 	if(!currType->hasFinished)
@@ -6211,6 +6572,8 @@ void TypePrototypeFinish()
 // End of type definition
 void TypeFinish()
 {
+	overloadCacheGeneration++;
+
 	newType->FinalizeMembers();
 
 	// Wrap all member function definitions into one expression list
@@ -6478,6 +6841,9 @@ void TypeInstanceGeneric(const char* pos, TypeInfo* base, unsigned aliases, bool
 	if(instanceDepth++ > NULLC_MAX_GENERIC_INSTANCE_DEPTH)
 		ThrowError(pos, "ERROR: reached maximum generic type instance depth (%d)", NULLC_MAX_GENERIC_INSTANCE_DEPTH);
 
+	unsigned lastPhase = CodeInfo::SetCompilePhase(NULLC_PHASE_GENERICS);
+	CodeInfo::compileStatistics.genericTypeInstances++;
+
 	// If not found, create a new type
 	SetCurrentAlignment(base->alignBytes);
 	// Save the type that may be in definition
@@ -6514,6 +6880,7 @@ void TypeInstanceGeneric(const char* pos, TypeInfo* base, unsigned aliases, bool
 				errPos -= 2;
 			*errPos++ = 0;
 			CodeInfo::lastError = CompilerError(errorReport, pos);
+			CodeInfo::SetCompilePhase(lastPhase);
 			longjmp(CodeInfo::errorHandler, 1);
 		}
 	}else{
@@ -6532,6 +6899,8 @@ void TypeInstanceGeneric(const char* pos, TypeInfo* base, unsigned aliases, bool
 	methodCount = currentDefinedTypeMethodCount;
 	newType = currentDefinedType;
 
+	CodeInfo::SetCompilePhase(lastPhase);
+
 	instanceDepth--;
 }
 
@@ -6797,6 +7166,26 @@ void CallbackInitialize()
 
 	currAlign = TypeInfo::ALIGNMENT_UNSPECIFIED;
 	inplaceVariableNum = 1;
+#ifdef NULLC_INLINE_FUNCTIONS
+	inlineEnabled = true;
+#else
+	inlineEnabled = false;
+#endif
+	pureCallsEnabled = true;
+	inlineFrameNum = 1;
+	optimizerTemporaryNum = 1;
+
+	evaluatedCallCount = 0;
+	failedCallCount = 0;
+	evaluationStepCount = 0;
+
+	overloadCache.init();
+	overloadCache.clear();
+	overloadCacheEntries.clear();
+	overloadCacheKeys.clear();
+	overloadCacheGeneration = 0;
+	overloadCacheHits = 0;
+	overloadCacheMisses = 0;
 
 	varInfoTop.clear();
 	varInfoTop.push_back(VarTopInfo(0,0));
@@ -6807,6 +7196,8 @@ void CallbackInitialize()
 	cycleDepth.clear();
 	cycleDepth.push_back(0);
 
+	forEachIndex.clear();
+
 	lostGlobalList = NULL;
 
 	funcMap.init();
@@ -6874,6 +7265,7 @@ void CallbackReset()
 	varInfoTop.reset();
 	funcInfoTop.reset();
 	cycleDepth.reset();
+	forEachIndex.reset();
 	currDefinedFunc.reset();
 	delayedInstance.reset();
 	bestFuncList.reset();
@@ -6889,14 +7281,19 @@ void CallbackReset()
 	namespaceStack.reset();
 	explicitTypesStack.reset();
 	namedArgumentBackup.reset();
+	evaluationMemory.reset();
+	overloadCache.reset();
+	overloadCacheEntries.reset();
+	overloadCacheKeys.reset();
+	overloadKey.reset();
 
-	TypeInfo::typeInfoPool.~ChunkedStackPool();
+	TypeInfo::typeInfoPool.Reset();
 	TypeInfo::SetPoolTop(0);
-	VariableInfo::variablePool.~ChunkedStackPool();
+	VariableInfo::variablePool.Reset();
 	VariableInfo::SetPoolTop(0);
-	FunctionInfo::functionPool.~ChunkedStackPool();
+	FunctionInfo::functionPool.Reset();
 	FunctionInfo::SetPoolTop(0);
-	NamespaceInfo::namespacePool.~ChunkedStackPool();
+	NamespaceInfo::namespacePool.Reset();
 	NamespaceInfo::ResetPool();
 
 	NULLC::dealloc(errorReport);
@@ -208,6 +208,15 @@ void RestoreNamespaces(bool undo, NamespaceInfo *parent, unsigned& prevBackupSiz
 unsigned int GetGlobalSize();
 void SetGlobalSize(unsigned int offset);
 
+void SetInlineNodeLimit(unsigned int limit);
+void SetInlineEnabled(bool enabled);
+void SetPureCallsEnabled(bool enabled);
+void SetEvaluationLimits(unsigned int memorySize, unsigned int stepCount);
+void GetEvaluationStatistics(unsigned int *evaluatedCalls, unsigned int *failedCalls, unsigned int *stepCount);
+void GetOverloadCacheStatistics(unsigned int *hits, unsigned int *misses);
+
+void OptimizeGlobalCode();
+
 void CallbackReset();
 
 FunctionInfo* InstanceGenericFunctionForType(const char* pos, FunctionInfo *info, TypeInfo *dstPreferred, unsigned count, bool create, bool silentError, NodeZeroOP **funcDefNode = NULL);
@@ -119,11 +119,19 @@ TypeInfo* CodeInfo::GetArrayType(TypeInfo* type, unsigned int sizeInArgument)
 	return newInfo;
 }
 
+extern HashMap<FunctionInfo*>	funcMap;
+
 int CodeInfo::FindFunctionByName(unsigned int hash, int startPos)
 {
-	for(int i = startPos; i >= 0; i--)
-		if(funcInfo[i]->nameHash == hash && funcInfo[i]->visible && !((funcInfo[i]->address & 0x80000000) && !(funcInfo[i]->address == -1)))
-			return i;
+	// Functions with the same name are placed in function map from the last one to the first one
+	HashMap<FunctionInfo*>::Node *curr = funcMap.first(hash);
+	while(curr)
+	{
+		FunctionInfo *info = curr->value;
+		if(int(info->indexInArr) <= startPos && info->visible && !((info->address & 0x80000000) && !(info->address == -1)))
+			return info->indexInArr;
+		curr = funcMap.next(curr);
+	}
 
 	return -1;
 }
@@ -132,3 +140,44 @@ unsigned int CodeInfo::FindFunctionByPtr(FunctionInfo* funcPtr)
 {
 	return funcPtr ? funcPtr->indexInArr : ~0u;
 }
+
+unsigned int	compilePhase = NULLC_PHASE_COUNT;
+double			compilePhaseStart = 0.0;
+unsigned int	compilePhaseAllocations = 0;
+
+unsigned int CodeInfo::SetCompilePhase(unsigned int phase)
+{
+	unsigned int lastPhase = compilePhase;
+	double time = NULLC::GetPreciseTime();
+
+	// Memory is tracked only while one of the phases is active
+	if(lastPhase == NULLC_PHASE_COUNT && phase != NULLC_PHASE_COUNT)
+		NULLC::StartMemoryTracking();
+
+	if(lastPhase != NULLC_PHASE_COUNT)
+	{
+		NULLCPhaseStatistics &stats = compileStatistics.phases[lastPhase];
+		stats.time += time - compilePhaseStart;
+		stats.allocations += NULLC::allocationCount - compilePhaseAllocations;
+		if(NULLC::peakMemory > stats.peakMemory)
+			stats.peakMemory = (unsigned int)NULLC::peakMemory;
+	}
+
+	compilePhase = phase;
+	compilePhaseStart = time;
+	compilePhaseAllocations = NULLC::allocationCount;
+
+	if(lastPhase != NULLC_PHASE_COUNT && phase == NULLC_PHASE_COUNT)
+		NULLC::StopMemoryTracking();
+
+	// Peak is measured from the amount of memory that is held at the phase start
+	NULLC::peakMemory = NULLC::allocatedMemory;
+
+	return lastPhase;
+}
+
+void CodeInfo::ResetCompileStatistics()
+{
+	memset(&compileStatistics, 0, sizeof(compileStatistics));
+	NodeZeroOP::createdNodes = 0;
+}
@@ -156,4 +156,12 @@ namespace CodeInfo
 
 	// Search for the function index by having pointer to it
 	unsigned int FindFunctionByPtr(FunctionInfo* funcInfo);
+
+	// Time and memory spent in compilation phases since the last reset
+	extern NULLCCompileStatistics	compileStatistics;
+
+	// Time and memory are accounted to the specified phase until the next call, NULLC_PHASE_COUNT stops the accounting. Function returns previous phase
+	unsigned int SetCompilePhase(unsigned int phase);
+
+	void ResetCompileStatistics();
 };
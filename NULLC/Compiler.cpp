@@ -437,6 +437,8 @@ Compiler::Compiler()
 	GetBytecode(&bytecode);
 	BinaryCache::PutBytecode("$base$.nc", bytecode, NULL, 0);
 
+	CodeInfo::SetCompilePhase(NULLC_PHASE_COUNT);
+
 #ifndef NULLC_NO_EXECUTOR
 	AddModuleFunction("$base$", (void (*)())NULLC::Assert, "assert", 0);
 	AddModuleFunction("$base$", (void (*)())NULLC::Assert2, "assert", 1);
@@ -539,7 +541,17 @@ Compiler::~Compiler()
 	NodeSwitchExpr::fixQueue.reset();
 
 	NodeFuncCall::memoList.reset();
-	NodeFuncCall::memoPool.~ChunkedStackPool();
+	NodeFuncCall::memoPool.Reset();
+
+	TreeOptimizer::escapedVars.reset();
+	TreeOptimizer::writtenVars.reset();
+	TreeOptimizer::readVars.reset();
+	TreeOptimizer::hoistedList.reset();
+	TreeOptimizer::availableList.reset();
+	TreeOptimizer::temporaryList.reset();
+	TreeOptimizer::temporaryRegion.reset();
+	TreeOptimizer::allocationList.reset();
+	TreeOptimizer::accessVars.reset();
 
 	NodeZeroOP::ResetNodes();
 
@@ -1276,8 +1288,10 @@ bool Compiler::Compile(const char* str, bool noClear)
 		codeSourceRange.clear();
 	}
 	unsigned int lexStreamStart = lexer.GetStreamSize();
+	CodeInfo::SetCompilePhase(NULLC_PHASE_LEXING);
 	lexer.Lexify(str);
 	unsigned int lexStreamEnd = lexer.GetStreamSize();
+	CodeInfo::SetCompilePhase(NULLC_PHASE_IMPORTS);
 
 	unsigned moduleBase = moduleStack.size();
 
@@ -1348,6 +1362,7 @@ bool Compiler::Compile(const char* str, bool noClear)
 			importStack.push_back(pathHash);
 			bytecode = BuildModule(path, pathNoImport);
 			importStack.pop_back();
+			CodeInfo::SetCompilePhase(NULLC_PHASE_IMPORTS);
 			start = &lexer.GetStreamStart()[lexStreamStart + lexPos];
 			if(bytecode)
 				moduleStack.back().range = CodeRange(lexer.GetStreamStart()[moduleStack.back().stream].pos, lexer.GetStreamStart()[moduleStack.back().stream].pos + ((ByteCode*)bytecode)->sourceSize);
@@ -1388,6 +1403,16 @@ bool Compiler::Compile(const char* str, bool noClear)
 	}
 	moduleStack.shrink(moduleBase);
 
+	// Functions can be overridden at run time with std.dynamic, so calls to them are not inlined or reused
+	for(unsigned int i = 0; i < activeModules.size(); i++)
+	{
+		if(strcmp(activeModules[i].name, "std/dynamic.nc") == 0)
+		{
+			SetInlineEnabled(false);
+			SetPureCallsEnabled(false);
+		}
+	}
+
 	CompilerError::codeStart = str;
 	CompilerError::codeEnd = (lexer.GetStreamStart() + lexStreamEnd - 1)->pos;
 	CodeInfo::cmdInfoList.SetSourceStart(CompilerError::codeStart, CompilerError::codeEnd);
@@ -1395,6 +1420,8 @@ bool Compiler::Compile(const char* str, bool noClear)
 
 	RestoreRedirectionTables();
 
+	CodeInfo::SetCompilePhase(NULLC_PHASE_PARSING);
+
 	bool res;
 	if(!setjmp(CodeInfo::errorHandler))
 	{
@@ -1446,6 +1473,8 @@ bool Compiler::Compile(const char* str, bool noClear)
 				param = param->next;
 			}
 		}
+
+		OptimizeGlobalCode();
 	}else{
 		return false;
 	}
@@ -1468,6 +1497,8 @@ bool Compiler::Compile(const char* str, bool noClear)
 	StartGraphGeneration();
 #endif
 
+	CodeInfo::SetCompilePhase(NULLC_PHASE_CODEGEN);
+
 	CodeInfo::cmdList.push_back(VMCmd(cmdJmp));
 	unsigned coroutineContext = 0;
 	for(unsigned int i = 0; i < CodeInfo::funcDefList.size(); i++)
@@ -1568,6 +1599,19 @@ bool Compiler::SaveListing(const char *fileName)
 		else
 			fprintf(compiledAsm, "// %d %s\r\n", i, instBuf);
 	}
+
+	unsigned int indexCount = 0, uncheckedCount = 0;
+	for(unsigned int i = 0; i < CodeInfo::cmdList.size(); i++)
+	{
+		if(CodeInfo::cmdList[i].cmd == cmdIndex || CodeInfo::cmdList[i].cmd == cmdIndexStk)
+		{
+			indexCount++;
+			if(CodeInfo::cmdList[i].flag & INDEX_UNCHECKED)
+				uncheckedCount++;
+		}
+	}
+	fprintf(compiledAsm, "// Array bounds checks removed: %d of %d\r\n", uncheckedCount, indexCount);
+
 	fclose(compiledAsm);
 
 	return true;
@@ -2010,8 +2054,30 @@ bool CreateExternalInfo(ExternFuncInfo &fInfo, FunctionInfo &refFunc)
 	return true;
 }
 
+void Compiler::SetInlineLimit(unsigned int nodeCount)
+{
+	SetInlineNodeLimit(nodeCount);
+}
+
+void Compiler::SetEvaluationLimits(unsigned int memorySize, unsigned int stepCount)
+{
+	::SetEvaluationLimits(memorySize, stepCount);
+}
+
+void Compiler::GetEvaluationStatistics(unsigned int *evaluatedCalls, unsigned int *failedCalls, unsigned int *stepCount)
+{
+	::GetEvaluationStatistics(evaluatedCalls, failedCalls, stepCount);
+}
+
+void Compiler::GetOverloadCacheStatistics(unsigned int *hits, unsigned int *misses)
+{
+	::GetOverloadCacheStatistics(hits, misses);
+}
+
 unsigned int Compiler::GetBytecode(char **bytecode)
 {
+	unsigned int lastPhase = CodeInfo::SetCompilePhase(NULLC_PHASE_BYTECODE);
+
 	// find out the size of generated bytecode
 	unsigned int size = sizeof(ByteCode);
 
@@ -2404,6 +2470,7 @@ unsigned int Compiler::GetBytecode(char **bytecode)
 		offsetToGlobal += refFunc->codeSize;
 
 		funcInfo.nameHash = refFunc->nameHash;
+		funcInfo.isInlined = refFunc->inlined;
 		funcInfo.namespaceHash = refFunc->parentNamespace ? refFunc->parentNamespace->hash : ~0u;
 
 		funcInfo.funcCat = (unsigned char)refFunc->type;
@@ -2610,6 +2677,8 @@ unsigned int Compiler::GetBytecode(char **bytecode)
 
 	assert(externVariableInfoCount == actualExternVariableInfoCount);
 
+	CodeInfo::SetCompilePhase(lastPhase);
+
 	return size;
 }
 
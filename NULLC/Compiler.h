@@ -67,6 +67,11 @@ public:
 	void	TranslateToC(const char* fileName, const char *mainName);
 
 	unsigned int	GetBytecode(char** bytecode);
+
+	void	SetInlineLimit(unsigned int nodeCount);
+	void	SetEvaluationLimits(unsigned int memorySize, unsigned int stepCount);
+	void	GetEvaluationStatistics(unsigned int *evaluatedCalls, unsigned int *failedCalls, unsigned int *stepCount);
+	void	GetOverloadCacheStatistics(unsigned int *hits, unsigned int *misses);
 private:
 	void	ClearState();
 	bool	ImportModuleNamespaces(const char* bytecode);
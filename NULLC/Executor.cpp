@@ -832,7 +832,27 @@ Executor::~Executor()
 }
 
 #define genStackSize (genStackTop-genStackPtr)
-#define RUNTIME_ERROR(test, desc)	if(test){ fcallStack.push_back(cmdStream); cmdStream = NULL; strcpy(execError, desc); break; }
+#define RUNTIME_ERROR(test, desc)	if(test){ fcallStack.push_back(cmdStream); cmdStream = NULL; strcpy(execError, desc); VM_BREAK; }
+
+// int variable in the stack frame referenced by cmdPushInt or cmdMovInt instruction
+#define VM_INT_SLOT(ins) (*(int*)(&genParams[(ins).argument + (paramBase * (ins).flag)]))
+
+#ifdef NULLC_VM_PROFILE_INSTRUCTIONS
+	#define VM_PROFILE_INSTRUCTION() insCallCount[cmd.cmd]++; insExecuted++;
+#else
+	#define VM_PROFILE_INSTRUCTION()
+#endif
+
+#ifdef NULLC_VM_COMPUTED_GOTO
+	// Every instruction handler fetches the next instruction and jumps straight to its handler through the label table
+	#define VM_SWITCH(x) goto *dispatchTable[x];
+	#define VM_CASE(x) vm_##x:
+	#define VM_BREAK { if(!cmdStream) goto vm_exit; cmd = *cmdStream; cmdStream++; VM_PROFILE_INSTRUCTION(); goto *dispatchTable[cmd.cmd]; }
+#else
+	#define VM_SWITCH(x) switch(x)
+	#define VM_CASE(x) case x:
+	#define VM_BREAK break
+#endif
 
 void Executor::InitExecution()
 {
@@ -858,6 +878,10 @@ void Executor::InitExecution()
 	// Add return after the last instruction to end execution of code with no return at the end
 	exLinker->exCode.push_back(VMCmd(cmdReturn, bitRetError, 0, 1));
 
+	// Replace common instruction sequences with fused instructions, breakpoints require original instructions
+	if(!breakCode.size())
+		CreateFusedInstructions();
+
 	// General stack
 	if(!genStackBase)
 	{
@@ -975,19 +999,73 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 	unsigned int insExecuted = 0;
 #endif
 
+#ifdef NULLC_VM_COMPUTED_GOTO
+	static const void* dispatchTable[] =
+	{
+		&&vm_cmdNop,
+		&&vm_cmdPushChar, &&vm_cmdPushShort, &&vm_cmdPushInt, &&vm_cmdPushFloat, &&vm_cmdPushDorL, &&vm_cmdPushCmplx,
+		&&vm_cmdPushCharStk, &&vm_cmdPushShortStk, &&vm_cmdPushIntStk, &&vm_cmdPushFloatStk, &&vm_cmdPushDorLStk, &&vm_cmdPushCmplxStk,
+		&&vm_cmdPushImmt,
+		&&vm_cmdMovChar, &&vm_cmdMovShort, &&vm_cmdMovInt, &&vm_cmdMovFloat, &&vm_cmdMovDorL, &&vm_cmdMovCmplx,
+		&&vm_cmdMovCharStk, &&vm_cmdMovShortStk, &&vm_cmdMovIntStk, &&vm_cmdMovFloatStk, &&vm_cmdMovDorLStk, &&vm_cmdMovCmplxStk,
+		&&vm_cmdPop,
+		&&vm_cmdDtoI, &&vm_cmdDtoL, &&vm_cmdDtoF, &&vm_cmdItoD, &&vm_cmdLtoD, &&vm_cmdItoL, &&vm_cmdLtoI,
+		&&vm_cmdIndex, &&vm_cmdIndexStk,
+		&&vm_cmdCopyDorL, &&vm_cmdCopyI,
+		&&vm_cmdGetAddr, &&vm_cmdFuncAddr, &&vm_cmdSetRangeStk,
+		&&vm_cmdJmp, &&vm_cmdJmpZ, &&vm_cmdJmpNZ,
+		&&vm_cmdCall, &&vm_cmdCallPtr, &&vm_cmdReturn, &&vm_cmdYield,
+		&&vm_cmdPushVTop,
+		&&vm_cmdAdd, &&vm_cmdSub, &&vm_cmdMul, &&vm_cmdDiv, &&vm_cmdPow, &&vm_cmdMod, &&vm_cmdLess, &&vm_cmdGreater, &&vm_cmdLEqual, &&vm_cmdGEqual, &&vm_cmdEqual, &&vm_cmdNEqual,
+		&&vm_cmdShl, &&vm_cmdShr, &&vm_cmdBitAnd, &&vm_cmdBitOr, &&vm_cmdBitXor, &&vm_cmdLogAnd, &&vm_cmdLogOr, &&vm_cmdLogXor,
+		&&vm_cmdAddL, &&vm_cmdSubL, &&vm_cmdMulL, &&vm_cmdDivL, &&vm_cmdPowL, &&vm_cmdModL, &&vm_cmdLessL, &&vm_cmdGreaterL, &&vm_cmdLEqualL, &&vm_cmdGEqualL, &&vm_cmdEqualL, &&vm_cmdNEqualL,
+		&&vm_cmdShlL, &&vm_cmdShrL, &&vm_cmdBitAndL, &&vm_cmdBitOrL, &&vm_cmdBitXorL, &&vm_cmdLogAndL, &&vm_cmdLogOrL, &&vm_cmdLogXorL,
+		&&vm_cmdAddD, &&vm_cmdSubD, &&vm_cmdMulD, &&vm_cmdDivD, &&vm_cmdPowD, &&vm_cmdModD, &&vm_cmdLessD, &&vm_cmdGreaterD, &&vm_cmdLEqualD, &&vm_cmdGEqualD, &&vm_cmdEqualD, &&vm_cmdNEqualD,
+		&&vm_cmdNeg, &&vm_cmdNegL, &&vm_cmdNegD,
+		&&vm_cmdBitNot, &&vm_cmdBitNotL,
+		&&vm_cmdLogNot, &&vm_cmdLogNotL,
+		&&vm_cmdIncI, &&vm_cmdIncD, &&vm_cmdIncL,
+		&&vm_cmdDecI, &&vm_cmdDecD, &&vm_cmdDecL,
+		&&vm_cmdCreateClosure, &&vm_cmdCloseUpvals,
+		&&vm_default, &&vm_cmdConvertPtr,
+#ifdef _M_X64
+		&&vm_default, &&vm_default, &&vm_cmdPushPtrImmt,
+#else
+		&&vm_default, &&vm_default, &&vm_default,
+#endif
+		&&vm_cmdCheckedRet,
+		&&vm_cmdPushIntPushImmt, &&vm_cmdPushIntPushInt, &&vm_cmdPushIntAddImmt, &&vm_cmdPushIntSubImmt, &&vm_cmdPushIntJmpZ,
+		&&vm_cmdGetAddrPushIntStk, &&vm_cmdIndexStkPushIntStk, &&vm_cmdMovIntPop, &&vm_cmdMovIntStkPop,
+		&&vm_cmdLessJmpZ, &&vm_cmdGreaterJmpZ, &&vm_cmdLEqualJmpZ, &&vm_cmdGEqualJmpZ, &&vm_cmdEqualJmpZ, &&vm_cmdNEqualJmpZ,
+		&&vm_cmdSetIntImmt, &&vm_cmdIncIntSlot, &&vm_cmdDecIntSlot,
+		&&vm_cmdAddIntSlots, &&vm_cmdSubIntSlots, &&vm_cmdMulIntSlots, &&vm_cmdAddIntSlotImmt, &&vm_cmdSubIntSlotImmt, &&vm_cmdMulIntSlotImmt,
+		&&vm_cmdLessJmpZIntSlots, &&vm_cmdGreaterJmpZIntSlots, &&vm_cmdLEqualJmpZIntSlots, &&vm_cmdGEqualJmpZIntSlots, &&vm_cmdEqualJmpZIntSlots, &&vm_cmdNEqualJmpZIntSlots,
+		&&vm_cmdLessJmpZIntSlotImmt, &&vm_cmdGreaterJmpZIntSlotImmt, &&vm_cmdLEqualJmpZIntSlotImmt, &&vm_cmdGEqualJmpZIntSlotImmt, &&vm_cmdEqualJmpZIntSlotImmt, &&vm_cmdNEqualJmpZIntSlotImmt,
+		&&vm_cmdIndexUnchecked, &&vm_cmdIndexStkUnchecked
+	};
+	typedef char dispatchTableSizeCheck[sizeof(dispatchTable) / sizeof(dispatchTable[0]) == cmdEnumCount ? 1 : -1];
+
+	VMCmd cmd;
+#endif
+
 	while(cmdStream)
 	{
+#ifdef NULLC_VM_COMPUTED_GOTO
+		cmd = *cmdStream;
+#else
 		const VMCmd cmd = *cmdStream;
+#endif
 		cmdStream++;
 
-		#ifdef NULLC_VM_PROFILE_INSTRUCTIONS
-			insCallCount[cmd.cmd]++;
-			insExecuted++;
-		#endif
+		VM_PROFILE_INSTRUCTION();
 
-		switch(cmd.cmd)
+		VM_SWITCH(cmd.cmd)
 		{
-		case cmdNop:
+#ifdef NULLC_VM_COMPUTED_GOTO
+		vm_default:
+			VM_BREAK;
+#endif
+		VM_CASE(cmdNop)
 			if(cmd.flag == EXEC_BREAK_SIGNAL || cmd.flag == EXEC_BREAK_ONE_HIT_WONDER)
 			{
 				RUNTIME_ERROR(breakFunction == NULL, "ERROR: break function isn't set");
@@ -1045,35 +1123,35 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				{
 					cmdStream[-1] = breakCode[target];
 					cmdStream--;
-					break;
+					VM_BREAK;
 				}
 				// Jump to external code
 				cmdStream = &breakCode[target];
-				break;
+				VM_BREAK;
 			}
 			cmdStream = cmdBase + cmd.argument;
-			break;
-		case cmdPushChar:
+			VM_BREAK;
+		VM_CASE(cmdPushChar)
 			genStackPtr--;
 			*genStackPtr = genParams[cmd.argument + (paramBase * cmd.flag)];
-			break;
-		case cmdPushShort:
+			VM_BREAK;
+		VM_CASE(cmdPushShort)
 			genStackPtr--;
 			*genStackPtr = *((short*)(&genParams[cmd.argument + (paramBase * cmd.flag)]));
-			break;
-		case cmdPushInt:
+			VM_BREAK;
+		VM_CASE(cmdPushInt)
 			genStackPtr--;
 			*genStackPtr = *((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)]));
-			break;
-		case cmdPushFloat:
+			VM_BREAK;
+		VM_CASE(cmdPushFloat)
 			genStackPtr -= 2;
 			*(double*)(genStackPtr) = (double)*((float*)(&genParams[cmd.argument + (paramBase * cmd.flag)]));
-			break;
-		case cmdPushDorL:
+			VM_BREAK;
+		VM_CASE(cmdPushDorL)
 			genStackPtr -= 2;
 			*(long long*)(genStackPtr) = vmLoadInt64(&genParams[cmd.argument + (paramBase * cmd.flag)]);
-			break;
-		case cmdPushCmplx:
+			VM_BREAK;
+		VM_CASE(cmdPushCmplx)
 		{
 			int valind = cmd.argument + (paramBase * cmd.flag);
 			unsigned int currShift = cmd.helper;
@@ -1084,9 +1162,9 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				*genStackPtr = *((unsigned int*)(&genParams[valind + currShift]));
 			}
 		}
-			break;
+			VM_BREAK;
 
-		case cmdPushCharStk:
+		VM_CASE(cmdPushCharStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr++;
@@ -1095,8 +1173,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			RUNTIME_ERROR(*genStackPtr == 0, "ERROR: null pointer access");
 			*genStackPtr = *((char*)NULL + cmd.argument + *genStackPtr);
 #endif
-			break;
-		case cmdPushShortStk:
+			VM_BREAK;
+		VM_CASE(cmdPushShortStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr++;
@@ -1105,8 +1183,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			RUNTIME_ERROR(*genStackPtr == 0, "ERROR: null pointer access");
 			*genStackPtr = *(short*)((char*)NULL + cmd.argument + *genStackPtr);
 #endif
-			break;
-		case cmdPushIntStk:
+			VM_BREAK;
+		VM_CASE(cmdPushIntStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr++;
@@ -1115,8 +1193,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			RUNTIME_ERROR(*genStackPtr == 0, "ERROR: null pointer access");
 			*genStackPtr = *(int*)((char*)NULL + cmd.argument + *genStackPtr);
 #endif
-			break;
-		case cmdPushFloatStk:
+			VM_BREAK;
+		VM_CASE(cmdPushFloatStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			*(double*)(genStackPtr) = (double)*(float*)(cmd.argument + *(char**)(genStackPtr));
@@ -1125,8 +1203,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr--;
 			*(double*)(genStackPtr) = (double)*(float*)((char*)NULL + cmd.argument + *(genStackPtr+1));
 #endif
-			break;
-		case cmdPushDorLStk:
+			VM_BREAK;
+		VM_CASE(cmdPushDorLStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			*(long long*)(genStackPtr) = *(long long*)(cmd.argument + *(char**)(genStackPtr));
@@ -1135,8 +1213,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr--;
 			*(long long*)(genStackPtr) = vmLoadInt64((char*)NULL + cmd.argument + *(genStackPtr+1));
 #endif
-			break;
-		case cmdPushCmplxStk:
+			VM_BREAK;
+		VM_CASE(cmdPushCmplxStk)
 		{
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
@@ -1155,29 +1233,29 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				*genStackPtr = *(unsigned int*)(start + currShift);
 			}
 		}
-			break;
+			VM_BREAK;
 
-		case cmdPushImmt:
+		VM_CASE(cmdPushImmt)
 			genStackPtr--;
 			*genStackPtr = cmd.argument;
-			break;
+			VM_BREAK;
 
-		case cmdMovChar:
+		VM_CASE(cmdMovChar)
 			genParams[cmd.argument + (paramBase * cmd.flag)] = (unsigned char)(*genStackPtr);
-			break;
-		case cmdMovShort:
+			VM_BREAK;
+		VM_CASE(cmdMovShort)
 			*((unsigned short*)(&genParams[cmd.argument + (paramBase * cmd.flag)])) = (unsigned short)(*genStackPtr);
-			break;
-		case cmdMovInt:
+			VM_BREAK;
+		VM_CASE(cmdMovInt)
 			*((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)])) = (int)(*genStackPtr);
-			break;
-		case cmdMovFloat:
+			VM_BREAK;
+		VM_CASE(cmdMovFloat)
 			*((float*)(&genParams[cmd.argument + (paramBase * cmd.flag)])) = (float)*(double*)(genStackPtr);
-			break;
-		case cmdMovDorL:
+			VM_BREAK;
+		VM_CASE(cmdMovDorL)
 			vmStoreInt64(&genParams[cmd.argument + (paramBase * cmd.flag)], *(long long*)(genStackPtr));
-			break;
-		case cmdMovCmplx:
+			VM_BREAK;
+		VM_CASE(cmdMovCmplx)
 		{
 			int valind = cmd.argument + (paramBase * cmd.flag);
 			unsigned int currShift = cmd.helper;
@@ -1188,9 +1266,9 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			}
 			assert(currShift == 0);
 		}
-			break;
+			VM_BREAK;
 
-		case cmdMovCharStk:
+		VM_CASE(cmdMovCharStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr += 2;
@@ -1200,8 +1278,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr++;
 			*((char*)NULL + cmd.argument + *(genStackPtr-1)) = (unsigned char)(*genStackPtr);
 #endif
-			break;
-		case cmdMovShortStk:
+			VM_BREAK;
+		VM_CASE(cmdMovShortStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr += 2;
@@ -1211,8 +1289,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr++;
 			*(unsigned short*)((char*)NULL + cmd.argument + *(genStackPtr-1)) = (unsigned short)(*genStackPtr);
 #endif
-			break;
-		case cmdMovIntStk:
+			VM_BREAK;
+		VM_CASE(cmdMovIntStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr += 2;
@@ -1222,9 +1300,9 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr++;
 			*(int*)((char*)NULL + cmd.argument + *(genStackPtr-1)) = (int)(*genStackPtr);
 #endif
-			break;
+			VM_BREAK;
 
-		case cmdMovFloatStk:
+		VM_CASE(cmdMovFloatStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr += 2;
@@ -1234,8 +1312,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr++;
 			*(float*)((char*)NULL + cmd.argument + *(genStackPtr-1)) = (float)*(double*)(genStackPtr);
 #endif
-			break;
-		case cmdMovDorLStk:
+			VM_BREAK;
+		VM_CASE(cmdMovDorLStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
 			genStackPtr += 2;
@@ -1245,8 +1323,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr++;
 			vmStoreInt64((char*)NULL + cmd.argument + *(genStackPtr-1), *(long long*)(genStackPtr));
 #endif
-			break;
-		case cmdMovCmplxStk:
+			VM_BREAK;
+		VM_CASE(cmdMovCmplxStk)
 		{
 #ifdef _M_X64
 			RUNTIME_ERROR(*(char**)genStackPtr == 0, "ERROR: null pointer access");
@@ -1265,41 +1343,41 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			}
 			assert(currShift == 0);
 		}
-			break;
+			VM_BREAK;
 
-		case cmdPop:
+		VM_CASE(cmdPop)
 			genStackPtr = (unsigned int*)((char*)(genStackPtr) + cmd.argument);
 
-			break;
+			VM_BREAK;
 
-		case cmdDtoI:
+		VM_CASE(cmdDtoI)
 			*(genStackPtr+1) = int(*(double*)(genStackPtr));
 			genStackPtr++;
-			break;
-		case cmdDtoL:
+			VM_BREAK;
+		VM_CASE(cmdDtoL)
 			*(long long*)(genStackPtr) = (long long)*(double*)(genStackPtr);
-			break;
-		case cmdDtoF:
+			VM_BREAK;
+		VM_CASE(cmdDtoF)
 			*((float*)(genStackPtr+1)) = float(*(double*)(genStackPtr));
 			genStackPtr++;
-			break;
-		case cmdItoD:
+			VM_BREAK;
+		VM_CASE(cmdItoD)
 			genStackPtr--;
 			*(double*)(genStackPtr) = double(*(int*)(genStackPtr+1));
-			break;
-		case cmdLtoD:
+			VM_BREAK;
+		VM_CASE(cmdLtoD)
 			*(double*)(genStackPtr) = double(*(long long*)(genStackPtr));
-			break;
-		case cmdItoL:
+			VM_BREAK;
+		VM_CASE(cmdItoL)
 			genStackPtr--;
 			*(long long*)(genStackPtr) = (long long)(*(int*)(genStackPtr+1));
-			break;
-		case cmdLtoI:
+			VM_BREAK;
+		VM_CASE(cmdLtoI)
 			genStackPtr++;
 			*genStackPtr = (int)*(long long*)(genStackPtr - 1);
-			break;
+			VM_BREAK;
 
-		case cmdIndex:
+		VM_CASE(cmdIndex)
 			RUNTIME_ERROR(*genStackPtr >= (unsigned int)cmd.argument, "ERROR: array index out of bounds");
 #ifdef _M_X64
 			*(char**)(genStackPtr+1) += cmd.helper * (*genStackPtr);
@@ -1307,8 +1385,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			*(char**)(genStackPtr+1) += cmd.helper * (*genStackPtr);
 #endif
 			genStackPtr++;
-			break;
-		case cmdIndexStk:
+			VM_BREAK;
+		VM_CASE(cmdIndexStk)
 #ifdef _M_X64
 			RUNTIME_ERROR(*genStackPtr >= *(genStackPtr+3), "ERROR: array index out of bounds");
 			*(char**)(genStackPtr+2) = *(char**)(genStackPtr+1) + cmd.helper * (*genStackPtr);
@@ -1318,19 +1396,19 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			*(int*)(genStackPtr+2) = *(genStackPtr+1) + cmd.helper * (*genStackPtr);
 			genStackPtr += 2;
 #endif
-			break;
+			VM_BREAK;
 
-		case cmdCopyDorL:
+		VM_CASE(cmdCopyDorL)
 			genStackPtr -= 2;
 			*genStackPtr = *(genStackPtr+2);
 			*(genStackPtr+1) = *(genStackPtr+3);
-			break;
-		case cmdCopyI:
+			VM_BREAK;
+		VM_CASE(cmdCopyI)
 			genStackPtr--;
 			*genStackPtr = *(genStackPtr+1);
-			break;
+			VM_BREAK;
 
-		case cmdGetAddr:
+		VM_CASE(cmdGetAddr)
 #ifdef _M_X64
 			genStackPtr -= 2;
 			*(void**)genStackPtr = cmd.argument + paramBase * cmd.helper + genParams.data;
@@ -1338,11 +1416,11 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			genStackPtr--;
 			*genStackPtr = cmd.argument + paramBase * cmd.helper + (int)(intptr_t)genParams.data;
 #endif
-			break;
-		case cmdFuncAddr:
-			break;
+			VM_BREAK;
+		VM_CASE(cmdFuncAddr)
+			VM_BREAK;
 
-		case cmdSetRangeStk:
+		VM_CASE(cmdSetRangeStk)
 		{
 			unsigned int count = cmd.argument;
 
@@ -1385,25 +1463,25 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				}
 			}
 		}
-			break;
+			VM_BREAK;
 
-		case cmdJmp:
+		VM_CASE(cmdJmp)
 			cmdStream = cmdBase + cmd.argument;
-			break;
+			VM_BREAK;
 
-		case cmdJmpZ:
+		VM_CASE(cmdJmpZ)
 			if(*genStackPtr == 0)
 				cmdStream = cmdBase + cmd.argument;
 			genStackPtr++;
-			break;
+			VM_BREAK;
 
-		case cmdJmpNZ:
+		VM_CASE(cmdJmpNZ)
 			if(*genStackPtr != 0)
 				cmdStream = cmdBase + cmd.argument;
 			genStackPtr++;
-			break;
+			VM_BREAK;
 
-		case cmdCall:
+		VM_CASE(cmdCall)
 		{
 			RUNTIME_ERROR(genStackPtr <= genStackBase+8, "ERROR: stack overflow");
 			unsigned int fAddress = exFunctions[cmd.argument].address;
@@ -1447,9 +1525,9 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 					ExtendParameterStack(oldBase, oldSize, cmdStream);
 			}
 		}
-			break;
+			VM_BREAK;
 
-		case cmdCallPtr:
+		VM_CASE(cmdCallPtr)
 		{
 			unsigned int paramSize = cmd.argument;
 			unsigned int fID = genStackPtr[paramSize >> 2];
@@ -1495,9 +1573,9 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 					ExtendParameterStack(oldBase, oldSize, cmdStream);
 			}
 		}
-			break;
+			VM_BREAK;
 
-		case cmdReturn:
+		VM_CASE(cmdReturn)
 			if(cmd.flag & bitRetError)
 			{
 				fcallStack.push_back(cmdStream); 
@@ -1506,7 +1584,7 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				errorState = !cmd.argument;
 				if(errorState)
 					strcpy(execError, "ERROR: function didn't return a value");
-				break;
+				VM_BREAK;
 			}
 			{
 				unsigned int *retValue = genStackPtr;
@@ -1527,14 +1605,14 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				errorState = false;
 				if(finalReturn == 0)
 					codeRunning = false;
-				break;
+				VM_BREAK;
 			}
 			cmdStream = fcallStack.back();
 			fcallStack.pop_back();
 			NULLC_UNWRAP(funcIDStack.pop_back());
-			break;
+			VM_BREAK;
 
-		case cmdPushVTop:
+		VM_CASE(cmdPushVTop)
 			genStackPtr--;
 			*genStackPtr = paramBase;
 			paramBase = genParams.size();
@@ -1556,21 +1634,21 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				if(cmd.argument - cmd.helper)
 					memset(genParams.data + paramBase + cmd.helper, 0, cmd.argument - cmd.helper);
 			}
-			break;
+			VM_BREAK;
 
-		case cmdAdd:
+		VM_CASE(cmdAdd)
 			*(int*)(genStackPtr+1) += *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdSub:
+			VM_BREAK;
+		VM_CASE(cmdSub)
 			*(int*)(genStackPtr+1) -= *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdMul:
+			VM_BREAK;
+		VM_CASE(cmdMul)
 			*(int*)(genStackPtr+1) *= *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdDiv:
+			VM_BREAK;
+		VM_CASE(cmdDiv)
 			if(*(int*)(genStackPtr))
 			{
 				*(int*)(genStackPtr+1) /= *(int*)(genStackPtr);
@@ -1580,12 +1658,12 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				cmdStream = NULL;
 			}
 			genStackPtr++;
-			break;
-		case cmdPow:
+			VM_BREAK;
+		VM_CASE(cmdPow)
 			*(int*)(genStackPtr+1) = vmIntPow(*(int*)(genStackPtr), *(int*)(genStackPtr+1));
 			genStackPtr++;
-			break;
-		case cmdMod:
+			VM_BREAK;
+		VM_CASE(cmdMod)
 			if(*(int*)(genStackPtr))
 			{
 				*(int*)(genStackPtr+1) %= *(int*)(genStackPtr);
@@ -1595,72 +1673,72 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				cmdStream = NULL;
 			}
 			genStackPtr++;
-			break;
-		case cmdLess:
+			VM_BREAK;
+		VM_CASE(cmdLess)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) < *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdGreater:
+			VM_BREAK;
+		VM_CASE(cmdGreater)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) > *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdLEqual:
+			VM_BREAK;
+		VM_CASE(cmdLEqual)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) <= *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdGEqual:
+			VM_BREAK;
+		VM_CASE(cmdGEqual)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) >= *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdEqual:
+			VM_BREAK;
+		VM_CASE(cmdEqual)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) == *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdNEqual:
+			VM_BREAK;
+		VM_CASE(cmdNEqual)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) != *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdShl:
+			VM_BREAK;
+		VM_CASE(cmdShl)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) << *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdShr:
+			VM_BREAK;
+		VM_CASE(cmdShr)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) >> *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdBitAnd:
+			VM_BREAK;
+		VM_CASE(cmdBitAnd)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) & *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdBitOr:
+			VM_BREAK;
+		VM_CASE(cmdBitOr)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) | *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdBitXor:
+			VM_BREAK;
+		VM_CASE(cmdBitXor)
 			*(int*)(genStackPtr+1) = *(int*)(genStackPtr+1) ^ *(int*)(genStackPtr);
 			genStackPtr++;
-			break;
-		case cmdLogAnd:
-		case cmdLogOr:
-			break;
-		case cmdLogXor:
+			VM_BREAK;
+		VM_CASE(cmdLogAnd)
+		VM_CASE(cmdLogOr)
+			VM_BREAK;
+		VM_CASE(cmdLogXor)
 			*(int*)(genStackPtr+1) = !!(*(int*)(genStackPtr+1)) ^ !!(*(int*)(genStackPtr));
 			genStackPtr++;
-			break;
+			VM_BREAK;
 
-		case cmdAddL:
+		VM_CASE(cmdAddL)
 			*(long long*)(genStackPtr+2) += *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdSubL:
+			VM_BREAK;
+		VM_CASE(cmdSubL)
 			*(long long*)(genStackPtr+2) -= *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdMulL:
+			VM_BREAK;
+		VM_CASE(cmdMulL)
 			*(long long*)(genStackPtr+2) *= *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdDivL:
+			VM_BREAK;
+		VM_CASE(cmdDivL)
 			if(*(long long*)(genStackPtr))
 			{
 				*(long long*)(genStackPtr+2) /= *(long long*)(genStackPtr);
@@ -1670,12 +1748,12 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				cmdStream = NULL;
 			}
 			genStackPtr += 2;
-			break;
-		case cmdPowL:
+			VM_BREAK;
+		VM_CASE(cmdPowL)
 			*(long long*)(genStackPtr+2) = vmLongPow(*(long long*)(genStackPtr), *(long long*)(genStackPtr+2));
 			genStackPtr += 2;
-			break;
-		case cmdModL:
+			VM_BREAK;
+		VM_CASE(cmdModL)
 			if(*(long long*)(genStackPtr))
 			{
 				*(long long*)(genStackPtr+2) %= *(long long*)(genStackPtr);
@@ -1685,154 +1763,154 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				cmdStream = NULL;
 			}
 			genStackPtr += 2;
-			break;
-		case cmdLessL:
+			VM_BREAK;
+		VM_CASE(cmdLessL)
 			*(int*)(genStackPtr+3) = *(long long*)(genStackPtr+2) < *(long long*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdGreaterL:
+			VM_BREAK;
+		VM_CASE(cmdGreaterL)
 			*(int*)(genStackPtr+3) = *(long long*)(genStackPtr+2) > *(long long*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdLEqualL:
+			VM_BREAK;
+		VM_CASE(cmdLEqualL)
 			*(int*)(genStackPtr+3) = *(long long*)(genStackPtr+2) <= *(long long*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdGEqualL:
+			VM_BREAK;
+		VM_CASE(cmdGEqualL)
 			*(int*)(genStackPtr+3) = *(long long*)(genStackPtr+2) >= *(long long*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdEqualL:
+			VM_BREAK;
+		VM_CASE(cmdEqualL)
 			*(int*)(genStackPtr+3) = *(long long*)(genStackPtr+2) == *(long long*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdNEqualL:
+			VM_BREAK;
+		VM_CASE(cmdNEqualL)
 			*(int*)(genStackPtr+3) = *(long long*)(genStackPtr+2) != *(long long*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdShlL:
+			VM_BREAK;
+		VM_CASE(cmdShlL)
 			*(long long*)(genStackPtr+2) = *(long long*)(genStackPtr+2) << *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdShrL:
+			VM_BREAK;
+		VM_CASE(cmdShrL)
 			*(long long*)(genStackPtr+2) = *(long long*)(genStackPtr+2) >> *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdBitAndL:
+			VM_BREAK;
+		VM_CASE(cmdBitAndL)
 			*(long long*)(genStackPtr+2) = *(long long*)(genStackPtr+2) & *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdBitOrL:
+			VM_BREAK;
+		VM_CASE(cmdBitOrL)
 			*(long long*)(genStackPtr+2) = *(long long*)(genStackPtr+2) | *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdBitXorL:
+			VM_BREAK;
+		VM_CASE(cmdBitXorL)
 			*(long long*)(genStackPtr+2) = *(long long*)(genStackPtr+2) ^ *(long long*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdLogAndL:
-		case cmdLogOrL:
-			break;
-		case cmdLogXorL:
+			VM_BREAK;
+		VM_CASE(cmdLogAndL)
+		VM_CASE(cmdLogOrL)
+			VM_BREAK;
+		VM_CASE(cmdLogXorL)
 			*(int*)(genStackPtr+3) = !!(*(long long*)(genStackPtr+2)) ^ !!(*(long long*)(genStackPtr));
 			genStackPtr += 3;
-			break;
+			VM_BREAK;
 
-		case cmdAddD:
+		VM_CASE(cmdAddD)
 			*(double*)(genStackPtr+2) += *(double*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdSubD:
+			VM_BREAK;
+		VM_CASE(cmdSubD)
 			*(double*)(genStackPtr+2) -= *(double*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdMulD:
+			VM_BREAK;
+		VM_CASE(cmdMulD)
 			*(double*)(genStackPtr+2) *= *(double*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdDivD:
+			VM_BREAK;
+		VM_CASE(cmdDivD)
 			*(double*)(genStackPtr+2) /= *(double*)(genStackPtr);
 			genStackPtr += 2;
-			break;
-		case cmdPowD:
+			VM_BREAK;
+		VM_CASE(cmdPowD)
 			*(double*)(genStackPtr+2) = pow(*(double*)(genStackPtr+2), *(double*)(genStackPtr));
 			genStackPtr += 2;
-			break;
-		case cmdModD:
+			VM_BREAK;
+		VM_CASE(cmdModD)
 			*(double*)(genStackPtr+2) = fmod(*(double*)(genStackPtr+2), *(double*)(genStackPtr));
 			genStackPtr += 2;
-			break;
-		case cmdLessD:
+			VM_BREAK;
+		VM_CASE(cmdLessD)
 			*(int*)(genStackPtr+3) = *(double*)(genStackPtr+2) < *(double*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdGreaterD:
+			VM_BREAK;
+		VM_CASE(cmdGreaterD)
 			*(int*)(genStackPtr+3) = *(double*)(genStackPtr+2) > *(double*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdLEqualD:
+			VM_BREAK;
+		VM_CASE(cmdLEqualD)
 			*(int*)(genStackPtr+3) = *(double*)(genStackPtr+2) <= *(double*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdGEqualD:
+			VM_BREAK;
+		VM_CASE(cmdGEqualD)
 			*(int*)(genStackPtr+3) = *(double*)(genStackPtr+2) >= *(double*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdEqualD:
+			VM_BREAK;
+		VM_CASE(cmdEqualD)
 			*(int*)(genStackPtr+3) = *(double*)(genStackPtr+2) == *(double*)(genStackPtr);
 			genStackPtr += 3;
-			break;
-		case cmdNEqualD:
+			VM_BREAK;
+		VM_CASE(cmdNEqualD)
 			*(int*)(genStackPtr+3) = *(double*)(genStackPtr+2) != *(double*)(genStackPtr);
 			genStackPtr += 3;
-			break;
+			VM_BREAK;
 
-		case cmdNeg:
+		VM_CASE(cmdNeg)
 			*(int*)(genStackPtr) = -*(int*)(genStackPtr);
-			break;
-		case cmdNegL:
+			VM_BREAK;
+		VM_CASE(cmdNegL)
 			*(long long*)(genStackPtr) = -*(long long*)(genStackPtr);
-			break;
-		case cmdNegD:
+			VM_BREAK;
+		VM_CASE(cmdNegD)
 			*(double*)(genStackPtr) = -*(double*)(genStackPtr);
-			break;
+			VM_BREAK;
 
-		case cmdBitNot:
+		VM_CASE(cmdBitNot)
 			*(int*)(genStackPtr) = ~*(int*)(genStackPtr);
-			break;
-		case cmdBitNotL:
+			VM_BREAK;
+		VM_CASE(cmdBitNotL)
 			*(long long*)(genStackPtr) = ~*(long long*)(genStackPtr);
-			break;
+			VM_BREAK;
 
-		case cmdLogNot:
+		VM_CASE(cmdLogNot)
 			*(int*)(genStackPtr) = !*(int*)(genStackPtr);
-			break;
-		case cmdLogNotL:
+			VM_BREAK;
+		VM_CASE(cmdLogNotL)
 			*(int*)(genStackPtr+1) = !*(long long*)(genStackPtr);
 			genStackPtr++;
-			break;
+			VM_BREAK;
 		
-		case cmdIncI:
+		VM_CASE(cmdIncI)
 			(*(int*)(genStackPtr))++;
-			break;
-		case cmdIncD:
+			VM_BREAK;
+		VM_CASE(cmdIncD)
 			*(double*)(genStackPtr) += 1.0;
-			break;
-		case cmdIncL:
+			VM_BREAK;
+		VM_CASE(cmdIncL)
 			(*(long long*)(genStackPtr))++;
-			break;
+			VM_BREAK;
 
-		case cmdDecI:
+		VM_CASE(cmdDecI)
 			(*(int*)(genStackPtr))--;
-			break;
-		case cmdDecD:
+			VM_BREAK;
+		VM_CASE(cmdDecD)
 			*(double*)(genStackPtr) -= 1.0;
-			break;
-		case cmdDecL:
+			VM_BREAK;
+		VM_CASE(cmdDecL)
 			(*(long long*)(genStackPtr))--;
-			break;
+			VM_BREAK;
 
-		case cmdCreateClosure:
+		VM_CASE(cmdCreateClosure)
 #ifdef _M_X64
 			ClosureCreate(&genParams[paramBase], cmd.helper, cmd.argument, *(ExternFuncInfo::Upvalue**)genStackPtr);
 			genStackPtr += 2;
@@ -1840,12 +1918,12 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 			ClosureCreate(&genParams[paramBase], cmd.helper, cmd.argument, (ExternFuncInfo::Upvalue*)(intptr_t)*genStackPtr);
 			genStackPtr++;
 #endif
-			break;
-		case cmdCloseUpvals:
+			VM_BREAK;
+		VM_CASE(cmdCloseUpvals)
 			CloseUpvalues(&genParams[paramBase], cmd.flag, cmd.argument);
-			break;
+			VM_BREAK;
 
-		case cmdConvertPtr:
+		VM_CASE(cmdConvertPtr)
 			if(!ConvertFromAutoRef(cmd.argument, *genStackPtr))
 			{
 				SafeSprintf(execError, 1024, "ERROR: cannot convert from %s ref to %s ref", &exLinker->exSymbols[exLinker->exTypes[*genStackPtr].offsetToName], &exLinker->exSymbols[exLinker->exTypes[cmd.argument].offsetToName]);
@@ -1853,16 +1931,16 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 				cmdStream = NULL;
 			}
 			genStackPtr++;
-			break;
+			VM_BREAK;
 #ifdef _M_X64
-		case cmdPushPtrImmt:
+		VM_CASE(cmdPushPtrImmt)
 			genStackPtr--;
 			*genStackPtr = cmd.argument;
 			genStackPtr--;
 			*genStackPtr = cmd.argument;
-			break;
+			VM_BREAK;
 #endif
-		case cmdYield:
+		VM_CASE(cmdYield)
 			// If flag is set, jump to saved offset
 			if(cmd.flag)
 			{
@@ -1884,8 +1962,8 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 					*closurePtr->ptr = 0;
 				}
 			}
-			break;
-		case cmdCheckedRet:
+			VM_BREAK;
+		VM_CASE(cmdCheckedRet)
 			if(*(void**)genStackPtr >= &genParams[paramBase] && *(void**)genStackPtr <= genParams.data + genParams.size())
 			{
 				ExternTypeInfo &type = exLinker->exTypes[cmd.argument];
@@ -1902,9 +1980,197 @@ void Executor::Run(unsigned int functionID, const char *arguments)
 					*(char**)genStackPtr = copy;
 				}
 			}
-			break;
+			VM_BREAK;
+
+		VM_CASE(cmdPushIntPushImmt)
+			genStackPtr -= 2;
+			*(genStackPtr + 1) = *((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)]));
+			*genStackPtr = cmdStream->argument;
+			cmdStream++;
+			VM_BREAK;
+		VM_CASE(cmdPushIntPushInt)
+			genStackPtr -= 2;
+			*(genStackPtr + 1) = *((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)]));
+			*genStackPtr = *((int*)(&genParams[cmdStream->argument + (paramBase * cmdStream->flag)]));
+			cmdStream++;
+			VM_BREAK;
+		VM_CASE(cmdPushIntAddImmt)
+			genStackPtr--;
+			*(int*)genStackPtr = *((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)])) + (int)cmdStream->argument;
+			cmdStream += 2;
+			VM_BREAK;
+		VM_CASE(cmdPushIntSubImmt)
+			genStackPtr--;
+			*(int*)genStackPtr = *((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)])) - (int)cmdStream->argument;
+			cmdStream += 2;
+			VM_BREAK;
+		VM_CASE(cmdPushIntJmpZ)
+			if(*((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)])) == 0)
+				cmdStream = cmdBase + cmdStream->argument;
+			else
+				cmdStream++;
+			VM_BREAK;
+
+		VM_CASE(cmdGetAddrPushIntStk)
+			genStackPtr--;
+			*genStackPtr = *(int*)(cmdStream->argument + cmd.argument + paramBase * cmd.helper + genParams.data);
+			cmdStream++;
+			VM_BREAK;
+		VM_CASE(cmdIndexStkPushIntStk)
+		{
+#ifdef _M_X64
+			RUNTIME_ERROR(*genStackPtr >= *(genStackPtr+3), "ERROR: array index out of bounds");
+			char *ptr = *(char**)(genStackPtr+1) + cmd.helper * (*genStackPtr);
+			cmdStream++;
+			RUNTIME_ERROR(ptr == 0, "ERROR: null pointer access");
+			genStackPtr += 3;
+#else
+			RUNTIME_ERROR(*genStackPtr >= *(genStackPtr+2), "ERROR: array index out of bounds");
+			char *ptr = (char*)NULL + *(genStackPtr+1) + cmd.helper * (*genStackPtr);
+			cmdStream++;
+			RUNTIME_ERROR(ptr == 0, "ERROR: null pointer access");
+			genStackPtr += 2;
+#endif
+			*genStackPtr = *(int*)(cmdStream[-1].argument + ptr);
+		}
+			VM_BREAK;
+		VM_CASE(cmdMovIntPop)
+			*((int*)(&genParams[cmd.argument + (paramBase * cmd.flag)])) = (int)(*genStackPtr);
+			genStackPtr = (unsigned int*)((char*)(genStackPtr) + cmdStream->argument);
+			cmdStream++;
+			VM_BREAK;
+		VM_CASE(cmdMovIntStkPop)
+#ifdef _M_X64
+			RUNTIME_ERROR(*(void**)genStackPtr == 0, "ERROR: null pointer access");
+			genStackPtr += 2;
+			*(int*)(cmd.argument + *(char**)(genStackPtr-2)) = (int)(*genStackPtr);
+#else
+			RUNTIME_ERROR(*genStackPtr == 0, "ERROR: null pointer access");
+			genStackPtr++;
+			*(int*)((char*)NULL + cmd.argument + *(genStackPtr-1)) = (int)(*genStackPtr);
+#endif
+			genStackPtr = (unsigned int*)((char*)(genStackPtr) + cmdStream->argument);
+			cmdStream++;
+			VM_BREAK;
+
+		VM_CASE(cmdLessJmpZ)
+			cmdStream = !(*(int*)(genStackPtr+1) < *(int*)(genStackPtr)) ? cmdBase + cmdStream->argument : cmdStream + 1;
+			genStackPtr += 2;
+			VM_BREAK;
+		VM_CASE(cmdGreaterJmpZ)
+			cmdStream = !(*(int*)(genStackPtr+1) > *(int*)(genStackPtr)) ? cmdBase + cmdStream->argument : cmdStream + 1;
+			genStackPtr += 2;
+			VM_BREAK;
+		VM_CASE(cmdLEqualJmpZ)
+			cmdStream = !(*(int*)(genStackPtr+1) <= *(int*)(genStackPtr)) ? cmdBase + cmdStream->argument : cmdStream + 1;
+			genStackPtr += 2;
+			VM_BREAK;
+		VM_CASE(cmdGEqualJmpZ)
+			cmdStream = !(*(int*)(genStackPtr+1) >= *(int*)(genStackPtr)) ? cmdBase + cmdStream->argument : cmdStream + 1;
+			genStackPtr += 2;
+			VM_BREAK;
+		VM_CASE(cmdEqualJmpZ)
+			cmdStream = !(*(int*)(genStackPtr+1) == *(int*)(genStackPtr)) ? cmdBase + cmdStream->argument : cmdStream + 1;
+			genStackPtr += 2;
+			VM_BREAK;
+		VM_CASE(cmdNEqualJmpZ)
+			cmdStream = !(*(int*)(genStackPtr+1) != *(int*)(genStackPtr)) ? cmdBase + cmdStream->argument : cmdStream + 1;
+			genStackPtr += 2;
+			VM_BREAK;
+
+		VM_CASE(cmdSetIntImmt)
+			VM_INT_SLOT(cmdStream[0]) = cmd.argument;
+			cmdStream += 2;
+			VM_BREAK;
+		VM_CASE(cmdIncIntSlot)
+			VM_INT_SLOT(cmd)++;
+			cmdStream += 3;
+			VM_BREAK;
+		VM_CASE(cmdDecIntSlot)
+			VM_INT_SLOT(cmd)--;
+			cmdStream += 3;
+			VM_BREAK;
+
+		VM_CASE(cmdAddIntSlots)
+			VM_INT_SLOT(cmdStream[2]) = VM_INT_SLOT(cmd) + VM_INT_SLOT(cmdStream[0]);
+			cmdStream += 4;
+			VM_BREAK;
+		VM_CASE(cmdSubIntSlots)
+			VM_INT_SLOT(cmdStream[2]) = VM_INT_SLOT(cmd) - VM_INT_SLOT(cmdStream[0]);
+			cmdStream += 4;
+			VM_BREAK;
+		VM_CASE(cmdMulIntSlots)
+			VM_INT_SLOT(cmdStream[2]) = VM_INT_SLOT(cmd) * VM_INT_SLOT(cmdStream[0]);
+			cmdStream += 4;
+			VM_BREAK;
+		VM_CASE(cmdAddIntSlotImmt)
+			VM_INT_SLOT(cmdStream[2]) = VM_INT_SLOT(cmd) + (int)cmdStream[0].argument;
+			cmdStream += 4;
+			VM_BREAK;
+		VM_CASE(cmdSubIntSlotImmt)
+			VM_INT_SLOT(cmdStream[2]) = VM_INT_SLOT(cmd) - (int)cmdStream[0].argument;
+			cmdStream += 4;
+			VM_BREAK;
+		VM_CASE(cmdMulIntSlotImmt)
+			VM_INT_SLOT(cmdStream[2]) = VM_INT_SLOT(cmd) * (int)cmdStream[0].argument;
+			cmdStream += 4;
+			VM_BREAK;
+
+		VM_CASE(cmdLessJmpZIntSlots)
+			cmdStream = !(VM_INT_SLOT(cmd) < VM_INT_SLOT(cmdStream[0])) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdGreaterJmpZIntSlots)
+			cmdStream = !(VM_INT_SLOT(cmd) > VM_INT_SLOT(cmdStream[0])) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdLEqualJmpZIntSlots)
+			cmdStream = !(VM_INT_SLOT(cmd) <= VM_INT_SLOT(cmdStream[0])) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdGEqualJmpZIntSlots)
+			cmdStream = !(VM_INT_SLOT(cmd) >= VM_INT_SLOT(cmdStream[0])) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdEqualJmpZIntSlots)
+			cmdStream = !(VM_INT_SLOT(cmd) == VM_INT_SLOT(cmdStream[0])) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdNEqualJmpZIntSlots)
+			cmdStream = !(VM_INT_SLOT(cmd) != VM_INT_SLOT(cmdStream[0])) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+
+		VM_CASE(cmdLessJmpZIntSlotImmt)
+			cmdStream = !(VM_INT_SLOT(cmd) < (int)cmdStream[0].argument) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdGreaterJmpZIntSlotImmt)
+			cmdStream = !(VM_INT_SLOT(cmd) > (int)cmdStream[0].argument) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdLEqualJmpZIntSlotImmt)
+			cmdStream = !(VM_INT_SLOT(cmd) <= (int)cmdStream[0].argument) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdGEqualJmpZIntSlotImmt)
+			cmdStream = !(VM_INT_SLOT(cmd) >= (int)cmdStream[0].argument) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdEqualJmpZIntSlotImmt)
+			cmdStream = !(VM_INT_SLOT(cmd) == (int)cmdStream[0].argument) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+		VM_CASE(cmdNEqualJmpZIntSlotImmt)
+			cmdStream = !(VM_INT_SLOT(cmd) != (int)cmdStream[0].argument) ? cmdBase + cmdStream[2].argument : cmdStream + 3;
+			VM_BREAK;
+
+		VM_CASE(cmdIndexUnchecked)
+			*(char**)(genStackPtr+1) += cmd.helper * (*genStackPtr);
+			genStackPtr++;
+			VM_BREAK;
+		VM_CASE(cmdIndexStkUnchecked)
+#ifdef _M_X64
+			*(char**)(genStackPtr+2) = *(char**)(genStackPtr+1) + cmd.helper * (*genStackPtr);
+#else
+			*(int*)(genStackPtr+2) = *(genStackPtr+1) + cmd.helper * (*genStackPtr);
+#endif
+			genStackPtr += 2;
+			VM_BREAK;
 		}
 	}
+#ifdef NULLC_VM_COMPUTED_GOTO
+vm_exit:
+#endif
 	// If there was an execution error
 	if(errorState)
 	{
@@ -2790,6 +3056,99 @@ void Executor::SetBreakFunction(unsigned (*callback)(unsigned int))
 	breakFunction = callback;
 }
 
+void Executor::CreateFusedInstructions()
+{
+	typedef char fusedBaseSizeCheck[sizeof(cmdFusedBase) / sizeof(cmdFusedBase[0]) == cmdEnumCount - cmdFusedFirst ? 1 : -1];
+
+	VMCmd *code = exLinker->exCode.data;
+	unsigned int count = exLinker->exCode.size();
+
+	// Every instruction that is fused falls through to the next one in the sequence, so the result of execution is the same
+	// Instructions after the first one are not modified, so jumps into the middle of a sequence and instruction source info stay valid
+	for(unsigned int i = 0; i + 1 < count; i++)
+	{
+		InstructionCode first = (InstructionCode)code[i].cmd;
+		InstructionCode second = cmdBaseInstruction(code[i + 1].cmd);
+		InstructionCode third = i + 2 < count ? cmdBaseInstruction(code[i + 2].cmd) : cmdNop;
+		InstructionCode fourth = i + 3 < count ? cmdBaseInstruction(code[i + 3].cmd) : cmdNop;
+		InstructionCode fifth = i + 4 < count ? cmdBaseInstruction(code[i + 4].cmd) : cmdNop;
+
+		// Result of a three-address instruction is stored to an int variable and removed from the temporary stack
+		bool storeResult = fourth == cmdMovInt && fifth == cmdPop && code[i + 4].argument == 4;
+		bool isArithmetic = third == cmdAdd || third == cmdSub || third == cmdMul;
+		bool isCompareJump = third >= cmdLess && third <= cmdNEqual && fourth == cmdJmpZ;
+
+		switch(first)
+		{
+		case cmdPushImmt:
+			if(second == cmdMovInt && third == cmdPop && code[i + 2].argument == 4)
+				code[i].cmd = cmdSetIntImmt;
+			break;
+		case cmdPushInt:
+			if(second == cmdPushInt && isArithmetic && storeResult)
+				code[i].cmd = (CmdID)(third == cmdAdd ? cmdAddIntSlots : (third == cmdSub ? cmdSubIntSlots : cmdMulIntSlots));
+			else if(second == cmdPushImmt && isArithmetic && storeResult)
+				code[i].cmd = (CmdID)(third == cmdAdd ? cmdAddIntSlotImmt : (third == cmdSub ? cmdSubIntSlotImmt : cmdMulIntSlotImmt));
+			else if(second == cmdPushInt && isCompareJump)
+				code[i].cmd = (CmdID)(cmdLessJmpZIntSlots + (third - cmdLess));
+			else if(second == cmdPushImmt && isCompareJump)
+				code[i].cmd = (CmdID)(cmdLessJmpZIntSlotImmt + (third - cmdLess));
+			else if((second == cmdIncI || second == cmdDecI) && third == cmdMovInt && fourth == cmdPop && code[i + 3].argument == 4 && code[i + 2].argument == code[i].argument && code[i + 2].flag == code[i].flag)
+				code[i].cmd = (CmdID)(second == cmdIncI ? cmdIncIntSlot : cmdDecIntSlot);
+			else if(second == cmdPushImmt && third == cmdAdd)
+				code[i].cmd = cmdPushIntAddImmt;
+			else if(second == cmdPushImmt && third == cmdSub)
+				code[i].cmd = cmdPushIntSubImmt;
+			else if(second == cmdPushImmt)
+				code[i].cmd = cmdPushIntPushImmt;
+			else if(second == cmdPushInt)
+				code[i].cmd = cmdPushIntPushInt;
+			else if(second == cmdJmpZ)
+				code[i].cmd = cmdPushIntJmpZ;
+			break;
+		case cmdGetAddr:
+			if(second == cmdPushIntStk)
+				code[i].cmd = cmdGetAddrPushIntStk;
+			break;
+		case cmdIndex:
+			if(code[i].flag & INDEX_UNCHECKED)
+				code[i].cmd = cmdIndexUnchecked;
+			break;
+		case cmdIndexStk:
+			if(code[i].flag & INDEX_UNCHECKED)
+				code[i].cmd = cmdIndexStkUnchecked;
+			else if(second == cmdPushIntStk)
+				code[i].cmd = cmdIndexStkPushIntStk;
+			break;
+		case cmdMovInt:
+			if(second == cmdPop)
+				code[i].cmd = cmdMovIntPop;
+			break;
+		case cmdMovIntStk:
+			if(second == cmdPop)
+				code[i].cmd = cmdMovIntStkPop;
+			break;
+		case cmdLess:
+		case cmdGreater:
+		case cmdLEqual:
+		case cmdGEqual:
+		case cmdEqual:
+		case cmdNEqual:
+			if(second == cmdJmpZ)
+				code[i].cmd = (CmdID)(cmdLessJmpZ + (first - cmdLess));
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+void Executor::RemoveFusedInstructions()
+{
+	for(unsigned int i = 0; i < exLinker->exCode.size(); i++)
+		exLinker->exCode[i].cmd = (CmdID)cmdBaseInstruction(exLinker->exCode[i].cmd);
+}
+
 void Executor::ClearBreakpoints()
 {
 	// Check all instructions for break instructions
@@ -2810,6 +3169,9 @@ bool Executor::AddBreakpoint(unsigned int instruction, bool oneHit)
 		SafeSprintf(execError, ERROR_BUFFER_SIZE, "ERROR: break position out of code range");
 		return false;
 	}
+	// Breakpoint can be placed inside a fused instruction sequence and it must save the original instruction
+	RemoveFusedInstructions();
+
 	unsigned int pos = breakCode.size();
 	if(exLinker->exCode[instruction].cmd == cmdNop)
 	{
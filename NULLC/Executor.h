@@ -42,6 +42,9 @@ private:
 	unsigned int	CreateFunctionGateway(FastVector<unsigned char>	&code, unsigned int funcID);
 	void	InitExecution();
 
+	void	CreateFusedInstructions();
+	void	RemoveFusedInstructions();
+
 	bool	codeRunning;
 
 	asmOperType		lastResultType;
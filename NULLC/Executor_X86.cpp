@@ -1004,7 +1004,10 @@ bool ExecutorX86::TranslateToNative()
 	unsigned int pos = lastInstructionCount;
 	while(pos < exCode.size())
 	{
-		VMCmd &cmd = exCode[pos];
+		VMCmd cmd = exCode[pos];
+
+		// Code could have been prepared for execution in VM, translate the original instruction sequence
+		cmd.cmd = (CmdID)cmdBaseInstruction(cmd.cmd);
 
 		unsigned int currSize = (int)(GetLastInstruction() - instList.data);
 		instList.count = currSize;
@@ -5,8 +5,7 @@
 template<typename Value>
 class HashMap
 {
-	static const unsigned int	bucketCount = 1024;
-	static const unsigned int	bucketMask = bucketCount - 1;
+	static const unsigned int	initialBucketCount = 1024;
 
 	ChunkedStackPool<4092>		nodePool;
 public:
@@ -20,11 +19,16 @@ public:
 	HashMap()
 	{
 		entries = NULL;
+		bucketCount = 0;
+		bucketMask = 0;
+		count = 0;
 	}
 	void init()
 	{
 		if(!entries)
 		{
+			bucketCount = initialBucketCount;
+			bucketMask = bucketCount - 1;
 			entries = NULLC::construct<Node*>(bucketCount);
 			memset(entries, 0, sizeof(Node*) * bucketCount);
 		}
@@ -40,17 +44,23 @@ public:
 		if(entries)
 			NULLC::destruct(entries, bucketCount);
 		entries = NULL;
-		nodePool.~ChunkedStackPool();
+		count = 0;
+		nodePool.Reset();
 	}
 
 	void clear()
 	{
 		nodePool.Clear();
 		memset(entries, 0, sizeof(Node*) * bucketCount);
+		count = 0;
 	}
 
 	void insert(unsigned int hash, Value value)
 	{
+		if(count >= bucketCount * 2)
+			grow();
+		count++;
+
 		unsigned int bucket = hash & bucketMask;
 		Node *n = (Node*)nodePool.Allocate(sizeof(Node));
 		n->value = value;
@@ -74,6 +84,7 @@ public:
 			prev->next = curr->next;
 		else
 			entries[bucket] = curr->next;
+		count--;
 	}
 
 	Value* find(unsigned int hash)
@@ -123,5 +134,41 @@ public:
 		return NULL;
 	}
 private:
+	// Double the bucket count so that chains stay short when the map holds many thousands of elements
+	void grow()
+	{
+		unsigned int newCount = bucketCount * 2;
+		Node **newEntries = NULLC::construct<Node*>(newCount);
+		memset(newEntries, 0, sizeof(Node*) * newCount);
+
+		for(unsigned int i = 0; i < bucketCount; i++)
+		{
+			// Reverse the chain first, so that elements with the same hash keep their order (the last inserted element comes first)
+			Node *curr = entries[i], *reversed = NULL;
+			while(curr)
+			{
+				Node *next = curr->next;
+				curr->next = reversed;
+				reversed = curr;
+				curr = next;
+			}
+			while(reversed)
+			{
+				Node *next = reversed->next;
+				unsigned int bucket = reversed->hash & (newCount - 1);
+				reversed->next = newEntries[bucket];
+				newEntries[bucket] = reversed;
+				reversed = next;
+			}
+		}
+
+		NULLC::destruct(entries, bucketCount);
+		entries = newEntries;
+		bucketCount = newCount;
+		bucketMask = newCount - 1;
+	}
+
 	Node	**entries;
+	unsigned int	bucketCount, bucketMask;
+	unsigned int	count;
 };
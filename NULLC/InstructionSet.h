@@ -17,6 +17,8 @@ const unsigned int CALL_BY_POINTER = (unsigned int)-1;
 const unsigned int EXTERNAL_FUNCTION = (unsigned int)-1;
 const unsigned char ADDRESS_ABOLUTE = 0;
 const unsigned char ADDRESS_RELATIVE = 1;
+// cmdIndex and cmdIndexStk flag that is set when compiler has proven that the index is inside array bounds
+const unsigned char INDEX_UNCHECKED = 1;
 
 enum InstructionCode
 {
@@ -200,6 +202,51 @@ enum InstructionCode
 
 	cmdCheckedRet,
 
+	// Fused instructions are created by the VM from common instruction sequences
+	// Only the first instruction of a sequence is replaced, the rest are left in place and are skipped by the fused instruction
+	cmdPushIntPushImmt,		// cmdPushInt, cmdPushImmt
+	cmdPushIntPushInt,		// cmdPushInt, cmdPushInt
+	cmdPushIntAddImmt,		// cmdPushInt, cmdPushImmt, cmdAdd
+	cmdPushIntSubImmt,		// cmdPushInt, cmdPushImmt, cmdSub
+	cmdPushIntJmpZ,			// cmdPushInt, cmdJmpZ
+	cmdGetAddrPushIntStk,	// cmdGetAddr, cmdPushIntStk
+	cmdIndexStkPushIntStk,	// cmdIndexStk, cmdPushIntStk
+	cmdMovIntPop,			// cmdMovInt, cmdPop
+	cmdMovIntStkPop,		// cmdMovIntStk, cmdPop
+	cmdLessJmpZ,			// cmdLess, cmdJmpZ
+	cmdGreaterJmpZ,			// cmdGreater, cmdJmpZ
+	cmdLEqualJmpZ,			// cmdLEqual, cmdJmpZ
+	cmdGEqualJmpZ,			// cmdGEqual, cmdJmpZ
+	cmdEqualJmpZ,			// cmdEqual, cmdJmpZ
+	cmdNEqualJmpZ,			// cmdNEqual, cmdJmpZ
+
+	// Three-address instructions that work directly with int variables in the stack frame (slots) without using the temporary stack
+	cmdSetIntImmt,			// cmdPushImmt, cmdMovInt, cmdPop
+	cmdIncIntSlot,			// cmdPushInt, cmdIncI, cmdMovInt, cmdPop
+	cmdDecIntSlot,			// cmdPushInt, cmdDecI, cmdMovInt, cmdPop
+	cmdAddIntSlots,			// cmdPushInt, cmdPushInt, cmdAdd, cmdMovInt, cmdPop
+	cmdSubIntSlots,			// cmdPushInt, cmdPushInt, cmdSub, cmdMovInt, cmdPop
+	cmdMulIntSlots,			// cmdPushInt, cmdPushInt, cmdMul, cmdMovInt, cmdPop
+	cmdAddIntSlotImmt,		// cmdPushInt, cmdPushImmt, cmdAdd, cmdMovInt, cmdPop
+	cmdSubIntSlotImmt,		// cmdPushInt, cmdPushImmt, cmdSub, cmdMovInt, cmdPop
+	cmdMulIntSlotImmt,		// cmdPushInt, cmdPushImmt, cmdMul, cmdMovInt, cmdPop
+	cmdLessJmpZIntSlots,	// cmdPushInt, cmdPushInt, cmdLess, cmdJmpZ
+	cmdGreaterJmpZIntSlots,	// cmdPushInt, cmdPushInt, cmdGreater, cmdJmpZ
+	cmdLEqualJmpZIntSlots,	// cmdPushInt, cmdPushInt, cmdLEqual, cmdJmpZ
+	cmdGEqualJmpZIntSlots,	// cmdPushInt, cmdPushInt, cmdGEqual, cmdJmpZ
+	cmdEqualJmpZIntSlots,	// cmdPushInt, cmdPushInt, cmdEqual, cmdJmpZ
+	cmdNEqualJmpZIntSlots,	// cmdPushInt, cmdPushInt, cmdNEqual, cmdJmpZ
+	cmdLessJmpZIntSlotImmt,		// cmdPushInt, cmdPushImmt, cmdLess, cmdJmpZ
+	cmdGreaterJmpZIntSlotImmt,	// cmdPushInt, cmdPushImmt, cmdGreater, cmdJmpZ
+	cmdLEqualJmpZIntSlotImmt,	// cmdPushInt, cmdPushImmt, cmdLEqual, cmdJmpZ
+	cmdGEqualJmpZIntSlotImmt,	// cmdPushInt, cmdPushImmt, cmdGEqual, cmdJmpZ
+	cmdEqualJmpZIntSlotImmt,	// cmdPushInt, cmdPushImmt, cmdEqual, cmdJmpZ
+	cmdNEqualJmpZIntSlotImmt,	// cmdPushInt, cmdPushImmt, cmdNEqual, cmdJmpZ
+
+	// Array indexing without a bounds check, replaces instructions with INDEX_UNCHECKED flag
+	cmdIndexUnchecked,		// cmdIndex
+	cmdIndexStkUnchecked,	// cmdIndexStk
+
 	cmdEnumCount,
 };
 
@@ -232,9 +279,32 @@ static const char *vmInstructionText[] =
 	"CreateClosure", "CloseUpvals",
 	"PushTypeID", "ConvertPtr",
 	"PushPtr", "PushPtrStk", "PushPtrImmt",
-	"CheckedRet"
+	"CheckedRet",
+	"PushIntPushImmt", "PushIntPushInt", "PushIntAddImmt", "PushIntSubImmt", "PushIntJmpZ",
+	"GetAddrPushIntStk", "IndexStkPushIntStk", "MovIntPop", "MovIntStkPop",
+	"LessJmpZ", "GreaterJmpZ", "LEqualJmpZ", "GEqualJmpZ", "EqualJmpZ", "NEqualJmpZ",
+	"SetIntImmt", "IncIntSlot", "DecIntSlot",
+	"AddIntSlots", "SubIntSlots", "MulIntSlots", "AddIntSlotImmt", "SubIntSlotImmt", "MulIntSlotImmt",
+	"LessJmpZIntSlots", "GreaterJmpZIntSlots", "LEqualJmpZIntSlots", "GEqualJmpZIntSlots", "EqualJmpZIntSlots", "NEqualJmpZIntSlots",
+	"LessJmpZIntSlotImmt", "GreaterJmpZIntSlotImmt", "LEqualJmpZIntSlotImmt", "GEqualJmpZIntSlotImmt", "EqualJmpZIntSlotImmt", "NEqualJmpZIntSlotImmt",
+	"IndexUnchecked", "IndexStkUnchecked"
+};
+
+const unsigned int cmdFusedFirst = cmdPushIntPushImmt;
+
+// Conversion of fused instruction to the first instruction of the sequence it replaces
+static InstructionCode cmdFusedBase[] =
+{
+	cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdGetAddr, cmdIndexStk, cmdMovInt, cmdMovIntStk, cmdLess, cmdGreater, cmdLEqual, cmdGEqual, cmdEqual, cmdNEqual,
+	cmdPushImmt, cmdPushInt, cmdPushInt,
+	cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt,
+	cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt,
+	cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt, cmdPushInt,
+	cmdIndex, cmdIndexStk
 };
 
+__forceinline InstructionCode cmdBaseInstruction(CmdID cmd){ return cmd >= cmdFusedFirst ? cmdFusedBase[cmd - cmdFusedFirst] : (InstructionCode)cmd; }
+
 struct VMCmd
 {
 	VMCmd()
@@ -271,7 +341,8 @@ struct VMCmd
 		char *curr = buf;
 		curr += sprintf(curr, "%s", vmInstructionText[cmd]);
 
-		switch(cmd)
+		// Fused instruction operands are the operands of the first instruction in the sequence
+		switch(cmdBaseInstruction(cmd))
 		{
 		case cmdPushChar:
 		case cmdPushShort:
@@ -312,9 +383,12 @@ struct VMCmd
 			curr += sprintf(curr, " [%d%s] sizeof(%d)", argument, flag ? " + base" : "", helper);
 			break;
 
-		case cmdPop:
 		case cmdIndex:
 		case cmdIndexStk:
+			curr += sprintf(curr, " %d%s", argument, (flag & INDEX_UNCHECKED) ? " unchecked" : "");
+			break;
+
+		case cmdPop:
 		case cmdGetAddr:
 		case cmdFuncAddr:
 		case cmdPushVTop:
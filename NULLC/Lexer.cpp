@@ -1,5 +1,76 @@
 #include "Lexer.h"
 
+struct KeywordInfo
+{
+	const char	*name;
+	unsigned	length;
+	LexemeType	type;
+};
+
+static const KeywordInfo keywordList[] =
+{
+	{ "if", 2, lex_if },
+	{ "in", 2, lex_in },
+	{ "do", 2, lex_do },
+	{ "for", 3, lex_for },
+	{ "ref", 3, lex_ref },
+	{ "new", 3, lex_new },
+	{ "case", 4, lex_case },
+	{ "else", 4, lex_else },
+	{ "auto", 4, lex_auto },
+	{ "true", 4, lex_true },
+	{ "enum", 4, lex_enum },
+	{ "with", 4, lex_with },
+	{ "while", 5, lex_while },
+	{ "break", 5, lex_break },
+	{ "class", 5, lex_class },
+	{ "align", 5, lex_align },
+	{ "yield", 5, lex_yield },
+	{ "const", 5, lex_const },
+	{ "false", 5, lex_false },
+	{ "switch", 6, lex_switch },
+	{ "return", 6, lex_return },
+	{ "typeof", 6, lex_typeof },
+	{ "sizeof", 6, lex_sizeof },
+	{ "import", 6, lex_import },
+	{ "noalign", 7, lex_noalign },
+	{ "default", 7, lex_default },
+	{ "typedef", 7, lex_typedef },
+	{ "nullptr", 7, lex_nullptr },
+	{ "generic", 7, lex_generic },
+	{ "continue", 8, lex_continue },
+	{ "operator", 8, lex_operator },
+	{ "coroutine", 9, lex_coroutine },
+	{ "namespace", 9, lex_namespace },
+	{ "extendable", 10, lex_extendable },
+};
+
+static const unsigned keywordTableSize = 128;
+
+static inline unsigned GetKeywordHash(const char* str, unsigned length)
+{
+	return ((unsigned char)str[0] * 3 + (unsigned char)str[length - 1] * 12 + length) & (keywordTableSize - 1);
+}
+
+// Keyword table is indexed by a hash of identifier length and its first and last characters, which is different for every keyword
+// Table is filled during static initialization, so Lexify doesn't check it. Release builds catch a collision in the interface tests
+struct KeywordTable
+{
+	KeywordTable()
+	{
+		for(unsigned i = 0; i < sizeof(keywordList) / sizeof(keywordList[0]); i++)
+		{
+			unsigned hash = GetKeywordHash(keywordList[i].name, keywordList[i].length);
+			assert(!entries[hash]);
+			entries[hash] = &keywordList[i];
+		}
+	}
+
+	const KeywordInfo	*entries[keywordTableSize];
+};
+
+static KeywordTable keywordTable;
+
 void Lexer::Clear(unsigned count)
 {
 	if(count)
@@ -277,97 +348,11 @@ void Lexer::Lexify(const char* code)
 					pos++;
 				lLength = (int)(pos - code);
 
-				if(!(chartype_table[(unsigned char)*pos] & ct_symbol))
+				if(lLength >= 2 && lLength <= 10)
 				{
-					switch(lLength)
-					{
-					case 2:
-						if(memcmp(code, "if", 2) == 0)
-							lType = lex_if;
-						else if(memcmp(code, "in", 2) == 0)
-							lType = lex_in;
-						else if(memcmp(code, "do", 2) == 0)
-							lType = lex_do;
-						break;
-					case 3:
-						if(memcmp(code, "for", 3) == 0)
-							lType = lex_for;
-						else if(memcmp(code, "ref", 3) == 0)
-							lType = lex_ref;
-						else if(memcmp(code, "new", 3) == 0)
-							lType = lex_new;
-						break;
-					case 4:
-						if(memcmp(code, "case", 4) == 0)
-							lType = lex_case;
-						else if(memcmp(code, "else", 4) == 0)
-							lType = lex_else;
-						else if(memcmp(code, "auto", 4) == 0)
-							lType = lex_auto;
-						else if(memcmp(code, "true", 4) == 0)
-							lType = lex_true;
-						else if(memcmp(code, "enum", 4) == 0)
-							lType = lex_enum;
-						else if(memcmp(code, "with", 4) == 0)
-							lType = lex_with;
-						break;
-					case 5:
-						if(memcmp(code, "while", 5) == 0)
-							lType = lex_while;
-						else if(memcmp(code, "break", 5) == 0)
-							lType = lex_break;
-						else if(memcmp(code, "class", 5) == 0)
-							lType = lex_class;
-						else if(memcmp(code, "align", 5) == 0)
-							lType = lex_align;
-						else if(memcmp(code, "yield", 5) == 0)
-							lType = lex_yield;
-						else if(memcmp(code, "const", 5) == 0)
-							lType = lex_const;
-						else if(memcmp(code, "false", 5) == 0)
-							lType = lex_false;
-						break;
-					case 6:
-						if(memcmp(code, "switch", 6) == 0)
-							lType = lex_switch;
-						else if(memcmp(code, "return", 6) == 0)
-							lType = lex_return;
-						else if(memcmp(code, "typeof", 6) == 0)
-							lType = lex_typeof;
-						else if(memcmp(code, "sizeof", 6) == 0)
-							lType = lex_sizeof;
-						else if(memcmp(code, "import", 6) == 0)
-							lType = lex_import;
-						break;
-					case 7:
-						if(memcmp(code, "noalign", 7) == 0)
-							lType = lex_noalign;
-						else if(memcmp(code, "default", 7) == 0)
-							lType = lex_default;
-						else if(memcmp(code, "typedef", 7) == 0)
-							lType = lex_typedef;
-						else if(memcmp(code, "nullptr", 7) == 0)
-							lType = lex_nullptr;
-						else if(memcmp(code, "generic", 7) == 0)
-							lType = lex_generic;
-						break;
-					case 8:
-						if(memcmp(code, "continue", 8) == 0)
-							lType = lex_continue;
-						else if(memcmp(code, "operator", 8) == 0)
-							lType = lex_operator;
-						break;
-					case 9:
-						if(memcmp(code, "coroutine", 9) == 0)
-							lType = lex_coroutine;
-						else if(memcmp(code, "namespace", 9) == 0)
-							lType = lex_namespace;
-						break;
-					case 10:
-						if(memcmp(code, "extendable", 10) == 0)
-							lType = lex_extendable;
-						break;
-					}
+					const KeywordInfo *keyword = keywordTable.entries[GetKeywordHash(code, lLength)];
+					if(keyword && keyword->length == unsigned(lLength) && memcmp(code, keyword->name, lLength) == 0)
+						lType = keyword->type;
 				}
 
 				if(lType == lex_none)
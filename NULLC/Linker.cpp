@@ -322,6 +322,8 @@ bool Linker::LinkCode(const char *code)
 			// It is allowed for generic base function, generic function instances and default argument values
 			if(*(symbolInfo + fInfo->offsetToName) == '$' || fInfo->isGenericInstance || fInfo->funcType == 0)
 			{
+				// Generic function instance could be inlined in any of the modules
+				exFunctions[index].isInlined |= fInfo->isInlined;
 				exFunctions.push_back(exFunctions[index]);
 				funcMap.insert(exFunctions.back().nameHash, exFunctions.size()-1);
 				continue;
@@ -575,6 +575,9 @@ public:
 		generic = NULL;
 		genericBase = NULL;
 		functionNode = NULL;
+		inlineNode = NULL;
+		inlined = false;
+		trapFree = false;
 		type = NORMAL;
 		funcType = NULL;
 		allParamSize = 0;
@@ -690,12 +693,15 @@ public:
 	bool		visible;				// true until function goes out of scope
 	bool		implemented;			// false if only function prototype has been found.
 	bool		pure;					// function is pure and can possibly be evaluated at compile time
+	bool		trapFree;				// function is pure and its body can't raise a runtime error
 	bool		explicitlyReturned;		// an explicit return from function was compiled
 	bool		genericInstance;		// function is a generic function instance
 	bool		typeConstructor;
 	GenericContext	*generic;				// function is a template that will be resolved at the time of calling
 	GenericContext	*genericBase;			// pointer to a generic function base context
 	void		*functionNode;
+	void		*inlineNode;				// return node of a function whose calls can be replaced with the returned expression
+	bool		inlined;					// some calls to the function were replaced with the returned expression
 
 	enum FunctionCategory{ NORMAL, LOCAL, THISCALL, COROUTINE };
 	FunctionCategory	type;
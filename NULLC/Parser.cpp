@@ -3006,5 +3006,5 @@ bool ParseCode(Lexeme** str)
 void ParseReset()
 {
 	opStack.reset();
-	stringPool.~ChunkedStackPool();
+	stringPool.Reset();
 }
@@ -12,6 +12,12 @@ public:
 		size = chunkSize;
 	}
 	~ChunkedStackPool()
+	{
+		Reset();
+	}
+
+	// Free all chunks
+	void	Reset()
 	{
 		while(first)
 		{
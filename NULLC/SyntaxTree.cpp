@@ -102,6 +102,7 @@ TypeInfo*	ChooseBinaryOpResultType(TypeInfo* a, TypeInfo* b)
 // Node that doesn't have any child nodes
 
 ChunkedStackPool<65532>	NodeZeroOP::nodePool;
+unsigned int			NodeZeroOP::createdNodes = 0;
 
 NodeZeroOP::NodeZeroOP()
 {
@@ -520,6 +521,10 @@ NodeFuncCall::NodeFuncCall(FunctionInfo *info, FunctionType *type)
 	// Result type is fetched from function type
 	typeInfo = funcType->retType;
 
+	inlined = false;
+	inlineFrameShift = 0;
+	inlineFrameGlobal = false;
+
 	if(funcInfo && (funcInfo->type == FunctionInfo::LOCAL || funcInfo->type == FunctionInfo::COROUTINE))
 		first = TakeLastNode();
 
@@ -597,6 +602,30 @@ void NodeFuncCall::Compile()
 			paramType--;
 		}while(curr);
 	}
+	// Inlined function arguments are moved from stack to hidden variables that replace function stack frame
+	// Calls inside an expression that is being inlined are not inlined, because their hidden variables are located in a different stack frame
+	if(inlined && !inlineFunc)
+	{
+		unsigned int frameSize = funcInfo->allParamSize + NULLC_PTR_SIZE;
+		cmdList.push_back(VMCmd(cmdMovCmplx, inlineFrameGlobal ? ADDRESS_ABOLUTE : ADDRESS_RELATIVE, (unsigned short)frameSize, inlineFrameShift));
+		cmdList.push_back(VMCmd(cmdPop, frameSize));
+
+		NodeZeroOP *returnNode = (NodeZeroOP*)funcInfo->inlineNode;
+		NodeZeroOP *expression = static_cast<NodeOneOP*>(returnNode)->GetFirstNode();
+
+		inlineFunc = funcInfo;
+		inlineShift = inlineFrameShift;
+		inlineGlobal = inlineFrameGlobal;
+
+		expression->Compile();
+
+		inlineFunc = NULL;
+
+		// Convert it to the return type of the function
+		ConvertFirstToSecond(expression->typeInfo->stackType, returnNode->typeInfo->stackType);
+		return;
+	}
+
 	unsigned int ID = CodeInfo::FindFunctionByPtr(funcInfo);
 	unsigned short helper = (unsigned short)((typeInfo->type == TypeInfo::TYPE_COMPLEX || typeInfo->type == TypeInfo::TYPE_VOID) ? typeInfo->size : (bitRetSimple | operTypeForStackType[typeInfo->stackType]));
 	if(funcInfo)
@@ -605,6 +634,131 @@ void NodeFuncCall::Compile()
 		cmdList.push_back(VMCmd(cmdCallPtr, helper, funcType->paramSize));
 }
 
+FunctionInfo*	NodeFuncCall::inlineFunc = NULL;
+int				NodeFuncCall::inlineShift = 0;
+bool			NodeFuncCall::inlineGlobal = false;
+
+void NodeFuncCall::SetInlineFrame(int shift, bool global)
+{
+	assert(funcInfo && funcInfo->inlineNode);
+
+	inlined = true;
+	inlineFrameShift = shift;
+	funcInfo->inlined = true;
+	inlineFrameGlobal = global;
+}
+
+NodeZeroOP* NodeFuncCall::GetInlineReturn(FunctionInfo *func, NodeZeroOP *body, unsigned int nodeLimit)
+{
+	if(func->type != FunctionInfo::NORMAL && func->type != FunctionInfo::THISCALL)
+		return NULL;
+	if(func->closeUpvals || func->externalCount || func->retType == typeVoid || func->allParamSize % 4 != 0)
+		return NULL;
+	if(func->retType->type == TypeInfo::TYPE_COMPLEX && func->retType->size % 4 != 0)
+		return NULL;
+
+	// Function body must consist of a single return statement
+	if(body->nodeType == typeNodeExpressionList && !body->head)
+	{
+		body = static_cast<NodeExpressionList*>(body)->GetFirstNode();
+		if(!body || body->next)
+			return NULL;
+	}
+	if(body->nodeType != typeNodeReturnOp || body->head || !body->typeInfo)
+		return NULL;
+
+	NodeZeroOP *expression = static_cast<NodeOneOP*>(body)->GetFirstNode();
+	if(expression->nodeType == typeNodeZeroOp)
+		return NULL;
+
+	unsigned int cost = GetInlineCost(func, expression);
+	return cost <= nodeLimit ? body : NULL;
+}
+
+// Returns the number of nodes in an expression or ~0u if the expression cannot be compiled in place of a function call
+unsigned int NodeFuncCall::GetInlineCost(FunctionInfo *func, NodeZeroOP *node)
+{
+	const unsigned int forbidden = ~0u;
+
+	if(node->head)
+		return forbidden;
+
+	unsigned int cost = 1;
+	switch(node->nodeType)
+	{
+	case typeNodeNumber:
+		break;
+	case typeNodeGetAddress:{
+		NodeGetAddress *getAddress = static_cast<NodeGetAddress*>(node);
+		VariableInfo *variable = getAddress->varInfo;
+
+		// Only function arguments are available in the replaced stack frame
+		if(!variable->isGlobal && (variable->parentFunction != func || variable->pos >= func->allParamSize + NULLC_PTR_SIZE))
+			return forbidden;
+	}
+		break;
+	case typeNodeDereference:{
+		NodeDereference *dereference = static_cast<NodeDereference*>(node);
+
+		if(dereference->closureFunc || dereference->typeInfo->size == 0)
+			return forbidden;
+		if(dereference->originalNode->head)
+			return forbidden;
+		if(dereference->neutralized)
+			return GetInlineCost(func, dereference->originalNode);
+		if(dereference->knownAddress)
+			return dereference->first->nodeType == typeNodeGetAddress ? GetInlineCost(func, dereference->first) : forbidden;
+		cost = GetInlineCost(func, dereference->first);
+		return cost == forbidden ? forbidden : cost + 1;
+	}
+	case typeNodeUnaryOp:
+		// Check that the returned pointer doesn't point to the stack frame is performed for the frame of the caller
+		if(static_cast<NodeUnaryOp*>(node)->vmCmd.cmd == cmdCheckedRet)
+			return forbidden;
+		// fall through
+	case typeNodeShiftAddress:
+	case typeNodeConvertPtr:
+		cost = GetInlineCost(func, static_cast<NodeOneOP*>(node)->GetFirstNode());
+		return cost == forbidden ? forbidden : cost + 1;
+	case typeNodeBinaryOp:
+	case typeNodeArrayIndex:{
+		unsigned int costFirst = GetInlineCost(func, static_cast<NodeTwoOP*>(node)->GetFirstNode());
+		unsigned int costSecond = GetInlineCost(func, static_cast<NodeTwoOP*>(node)->GetSecondNode());
+		if(costFirst == forbidden || costSecond == forbidden)
+			return forbidden;
+		cost += costFirst + costSecond;
+	}
+		break;
+	case typeNodeFuncCall:{
+		NodeFuncCall *call = static_cast<NodeFuncCall*>(node);
+
+		if(call->funcInfo == func)
+			return forbidden;
+
+		// Function call is more expensive than a simple operation
+		cost = 4;
+		if(call->first)
+		{
+			unsigned int costContext = GetInlineCost(func, call->first);
+			if(costContext == forbidden)
+				return forbidden;
+			cost += costContext;
+		}
+		for(NodeZeroOP *curr = call->paramHead; curr; curr = curr->next)
+		{
+			unsigned int costParam = GetInlineCost(func, curr);
+			if(costParam == forbidden)
+				return forbidden;
+			cost += costParam;
+		}
+	}
+		break;
+	default:
+		return forbidden;
+	}
+	return cost;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Node that fetches variable value
 
@@ -661,6 +815,13 @@ void NodeGetAddress::Compile()
 
 	CompileExtra();
 
+	// Address of an argument of the function that is being inlined is redirected to a hidden variable
+	if(!varInfo->isGlobal && NodeFuncCall::inlineFunc)
+	{
+		cmdList.push_back(VMCmd(cmdGetAddr, NodeFuncCall::inlineGlobal ? 0 : 1, (trackAddress ? varInfo->pos : varAddress) + NodeFuncCall::inlineShift));
+		return;
+	}
+
 	cmdList.push_back(VMCmd(cmdGetAddr, varInfo->isGlobal ? 0 : 1, trackAddress ? varInfo->pos : varAddress));
 }
 
@@ -1005,6 +1166,7 @@ NodeArrayIndex::NodeArrayIndex(TypeInfo* parentType)
 
 	shiftValue = 0;
 	knownShift = false;
+	uncheckedIndex = false;
 
 	if(second->nodeType == typeNodeNumber && typeParent->arrSize != TypeInfo::UNSIZED_ARRAY)
 	{
@@ -1048,7 +1210,7 @@ void NodeArrayIndex::Compile()
 		// Convert it to integer and multiply by the size of the element
 		if(second->typeInfo->stackType != STYPE_INT)
 			cmdList.push_back(VMCmd(second->typeInfo->stackType == STYPE_DOUBLE ? cmdDtoI : cmdLtoI));
-		cmdList.push_back(VMCmd(typeParent->arrSize == TypeInfo::UNSIZED_ARRAY ? cmdIndexStk : cmdIndex, (unsigned short)typeParent->subType->size, typeParent->arrSize));
+		cmdList.push_back(VMCmd(typeParent->arrSize == TypeInfo::UNSIZED_ARRAY ? cmdIndexStk : cmdIndex, uncheckedIndex ? INDEX_UNCHECKED : 0, (unsigned short)typeParent->subType->size, typeParent->arrSize));
 	}
 }
 
@@ -1140,7 +1302,9 @@ void NodeDereference::Compile()
 
 			if(asmDT == DTYPE_COMPLEX_TYPE && typeInfo->size == 8)
 				asmDT = DTYPE_LONG;
-			if(knownAddress)
+			if(knownAddress && !absAddress && NodeFuncCall::inlineFunc)
+				cmdList.push_back(VMCmd(cmdPushType[asmDT>>2], NodeFuncCall::inlineGlobal ? ADDRESS_ABOLUTE : ADDRESS_RELATIVE, (unsigned short)typeInfo->size, addrShift + NodeFuncCall::inlineShift));
+			else if(knownAddress)
 				cmdList.push_back(VMCmd(cmdPushType[asmDT>>2], absAddress ? ADDRESS_ABOLUTE : ADDRESS_RELATIVE, (unsigned short)typeInfo->size, addrShift));
 			else
 				cmdList.push_back(VMCmd(cmdPushTypeStk[asmDT>>2], asmDT == DTYPE_DOUBLE ? 1 : 0, (unsigned short)typeInfo->size, addrShift));
@@ -2115,6 +2279,1103 @@ void NodeCreateAutoArray::Compile()
 	cmdList.push_back(VMCmd(cmdPushTypeID, first->typeInfo->subType->typeIndex));
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Optimizations of a complete function body
+
+FastVector<VariableInfo*>	TreeOptimizer::escapedVars;
+FastVector<VariableInfo*>	TreeOptimizer::writtenVars;
+FastVector<VariableInfo*>	TreeOptimizer::readVars;
+FastVector<NodeZeroOP*>		TreeOptimizer::hoistedList;
+FastVector<TreeOptimizer::AvailableValue>	TreeOptimizer::availableList;
+FastVector<VariableInfo*>	TreeOptimizer::temporaryList;
+FastVector<unsigned int>	TreeOptimizer::temporaryRegion;
+FastVector<TreeOptimizer::Allocation>	TreeOptimizer::allocationList;
+FastVector<VariableInfo*>	TreeOptimizer::accessVars;
+TreeOptimizer::CreateTemporary	TreeOptimizer::createTemporary = NULL;
+bool			TreeOptimizer::memoryWrite = false;
+bool			TreeOptimizer::pureCalls = false;
+unsigned int	TreeOptimizer::optimizedCount = 0;
+unsigned int	TreeOptimizer::regionIndex = 0;
+unsigned int	TreeOptimizer::loopDepth = 0;
+VariableInfo	*TreeOptimizer::loopCounter = NULL;
+NodeGetAddress	*TreeOptimizer::loopSize = NULL;
+unsigned int	TreeOptimizer::loopBound = 0;
+
+bool TreeOptimizer::VisitChildren(NodeZeroOP *node, bool (*visit)(NodeZeroOP*))
+{
+	for(NodeZeroOP *curr = node->head; curr; curr = curr->next)
+	{
+		if(!visit(curr))
+			return false;
+	}
+
+	switch(node->nodeType)
+	{
+	case typeNodeZeroOp:
+	case typeNodeNumber:
+	case typeNodeBreakOp:
+	case typeNodeContinueOp:
+	case typeNodeGetAddress:
+	case typeNodeGetUpvalue:
+	case typeNodeFuncDef:	// Local functions are optimized separately
+		return true;
+	case typeNodeOneOp:
+	case typeNodePopOp:
+	case typeNodeReturnOp:
+	case typeNodeBlockOp:
+	case typeNodeConvertPtr:
+	case typeNodeDereference:
+	case typeNodeShiftAddress:
+	case typeNodePreOrPostOp:
+	case typeNodeFunctionAddress:
+	case typeNodeUnaryOp:
+	case typeNodePointerCast:
+	case typeNodeGetFunctionContext:
+	case typeNodeGetCoroutineState:
+		return !static_cast<NodeOneOP*>(node)->first || visit(static_cast<NodeOneOP*>(node)->first);
+	case typeNodeTwoOp:
+	case typeNodeBinaryOp:
+	case typeNodeVariableSet:
+	case typeNodeVariableModify:
+	case typeNodeArrayIndex:
+	case typeNodeWhileExpr:
+	case typeNodeDoWhileExpr:
+	case typeNodeCreateUnsizedArray:
+		if(static_cast<NodeTwoOP*>(node)->first && !visit(static_cast<NodeTwoOP*>(node)->first))
+			return false;
+		return !static_cast<NodeTwoOP*>(node)->second || visit(static_cast<NodeTwoOP*>(node)->second);
+	case typeNodeThreeOp:
+	case typeNodeIfElseExpr:
+	case typeNodeForExpr:
+		if(static_cast<NodeThreeOP*>(node)->first && !visit(static_cast<NodeThreeOP*>(node)->first))
+			return false;
+		if(static_cast<NodeThreeOP*>(node)->second && !visit(static_cast<NodeThreeOP*>(node)->second))
+			return false;
+		if(static_cast<NodeThreeOP*>(node)->third && !visit(static_cast<NodeThreeOP*>(node)->third))
+			return false;
+		return node->nodeType != typeNodeForExpr || visit(static_cast<NodeForExpr*>(node)->fourth);
+	case typeNodeSwitchExpr:
+	{
+		NodeSwitchExpr *switchExpr = static_cast<NodeSwitchExpr*>(node);
+		if(switchExpr->first && !visit(switchExpr->first))
+			return false;
+		if(switchExpr->second && !visit(switchExpr->second))
+			return false;
+		for(NodeZeroOP *curr = switchExpr->conditionHead; curr; curr = curr->next)
+		{
+			if(!visit(curr))
+				return false;
+		}
+		for(NodeZeroOP *curr = switchExpr->blockHead; curr; curr = curr->next)
+		{
+			if(!visit(curr))
+				return false;
+		}
+		return !switchExpr->defaultCase || visit(switchExpr->defaultCase);
+	}
+	case typeNodeExpressionList:
+		for(NodeZeroOP *curr = static_cast<NodeExpressionList*>(node)->first; curr; curr = curr->next)
+		{
+			if(!visit(curr))
+				return false;
+		}
+		return true;
+	case typeNodeFuncCall:
+		// Expression of an inlined function belongs to the callee and is not a child node
+		if(static_cast<NodeFuncCall*>(node)->first && !visit(static_cast<NodeFuncCall*>(node)->first))
+			return false;
+		for(NodeZeroOP *curr = static_cast<NodeFuncCall*>(node)->paramHead; curr; curr = curr->next)
+		{
+			if(!visit(curr))
+				return false;
+		}
+		return true;
+	default:
+		break;
+	}
+
+	// Unknown node
+	return false;
+}
+
+// Get address node of a memory access that can use a known address
+NodeZeroOP* TreeOptimizer::GetAccessAddress(NodeZeroOP *node)
+{
+	switch(node->nodeType)
+	{
+	case typeNodeDereference:
+		if(static_cast<NodeDereference*>(node)->neutralized || static_cast<NodeDereference*>(node)->closureFunc)
+			return NULL;
+		return static_cast<NodeOneOP*>(node)->first;
+	case typeNodeVariableSet:
+		if(static_cast<NodeVariableSet*>(node)->arrSetAll)
+			return NULL;
+		return static_cast<NodeOneOP*>(node)->first;
+	case typeNodeVariableModify:
+	case typeNodePreOrPostOp:
+		return static_cast<NodeOneOP*>(node)->first;
+	default:
+		break;
+	}
+	return NULL;
+}
+
+// Get local variable if address node is a direct address of it
+VariableInfo* TreeOptimizer::GetLocalTarget(NodeZeroOP *address)
+{
+	if(!address || address->nodeType != typeNodeGetAddress)
+		return NULL;
+
+	NodeGetAddress *getAddress = static_cast<NodeGetAddress*>(address);
+	if(getAddress->varInfo->isGlobal || getAddress->trackAddress)
+		return NULL;
+	return getAddress->varInfo;
+}
+
+bool TreeOptimizer::IsEscaped(VariableInfo *variable)
+{
+	if(variable->usedAsExternal)
+		return true;
+	for(unsigned int i = 0; i < escapedVars.size(); i++)
+	{
+		if(escapedVars[i] == variable)
+			return true;
+	}
+	return false;
+}
+
+bool TreeOptimizer::IsWritten(VariableInfo *variable)
+{
+	for(unsigned int i = 0; i < writtenVars.size(); i++)
+	{
+		if(writtenVars[i] == variable)
+			return true;
+	}
+	return false;
+}
+
+// Pure functions don't access memory outside of their stack frame and their result depends only on the arguments
+bool TreeOptimizer::IsPureCall(NodeZeroOP *node)
+{
+	NodeFuncCall *call = static_cast<NodeFuncCall*>(node);
+
+	return pureCalls && call->funcInfo && call->funcInfo->pure && call->funcInfo->implemented && !call->first;
+}
+
+bool TreeOptimizer::IsReusableType(TypeInfo *type)
+{
+	return type->type != TypeInfo::TYPE_COMPLEX && type->type != TypeInfo::TYPE_VOID && type->arrLevel == 0;
+}
+
+// Find local variables that have their address taken
+bool TreeOptimizer::FindEscapes(NodeZeroOP *node)
+{
+	if(node->nodeType == typeNodeGetAddress)
+	{
+		if(!static_cast<NodeGetAddress*>(node)->varInfo->isGlobal && !IsEscaped(static_cast<NodeGetAddress*>(node)->varInfo))
+			escapedVars.push_back(static_cast<NodeGetAddress*>(node)->varInfo);
+		// Address node can have extra nodes attached
+		return VisitChildren(node, FindEscapes);
+	}
+
+	if(GetLocalTarget(GetAccessAddress(node)))
+	{
+		// Direct access to a local variable doesn't expose its address
+		for(NodeZeroOP *curr = node->head; curr; curr = curr->next)
+		{
+			if(!FindEscapes(curr))
+				return false;
+		}
+		for(NodeZeroOP *curr = GetAccessAddress(node)->head; curr; curr = curr->next)
+		{
+			if(!FindEscapes(curr))
+				return false;
+		}
+		if(node->nodeType == typeNodeVariableSet || node->nodeType == typeNodeVariableModify)
+			return FindEscapes(static_cast<NodeTwoOP*>(node)->second);
+		return true;
+	}
+
+	return VisitChildren(node, FindEscapes);
+}
+
+// Find local variables that are modified and check if any other memory is modified
+bool TreeOptimizer::CollectEffects(NodeZeroOP *node)
+{
+	switch(node->nodeType)
+	{
+	case typeNodeVariableSet:
+	case typeNodeVariableModify:
+	case typeNodePreOrPostOp:
+		if(VariableInfo *target = GetLocalTarget(GetAccessAddress(node)))
+		{
+			if(!IsWritten(target))
+				writtenVars.push_back(target);
+			if(IsEscaped(target))
+				memoryWrite = true;
+		}else{
+			memoryWrite = true;
+		}
+		break;
+	case typeNodeFuncCall:
+		if(!IsPureCall(node))
+			memoryWrite = true;
+		break;
+	case typeNodeBlockOp:	// Closes upvalues
+		memoryWrite = true;
+		break;
+	default:
+		break;
+	}
+
+	return VisitChildren(node, CollectEffects);
+}
+
+// Check if expression value doesn't change during loop execution, cost is increased by the amount of work that will be saved
+bool TreeOptimizer::IsInvariant(NodeZeroOP *node, unsigned int &cost)
+{
+	if(node->head)
+		return false;
+
+	switch(node->nodeType)
+	{
+	case typeNodeNumber:
+	case typeNodeGetAddress:
+		return true;
+	case typeNodeDereference:
+	{
+		NodeZeroOP *address = GetAccessAddress(node);
+		if(!address)
+			return false;
+
+		cost++;
+
+		if(VariableInfo *target = GetLocalTarget(address))
+			return !IsWritten(target) && (!IsEscaped(target) || !memoryWrite);
+
+		if(memoryWrite)
+			return false;
+
+		// Loads through a pointer are more expensive
+		if(!static_cast<NodeDereference*>(node)->knownAddress)
+			cost++;
+
+		return IsInvariant(address, cost);
+	}
+	case typeNodeShiftAddress:
+	case typeNodeConvertPtr:
+		return IsInvariant(static_cast<NodeOneOP*>(node)->first, cost);
+	case typeNodeUnaryOp:
+		if(static_cast<NodeUnaryOp*>(node)->vmCmd.cmd == cmdCheckedRet || static_cast<NodeUnaryOp*>(node)->vmCmd.cmd == cmdFuncAddr)
+			return false;
+		cost++;
+		return IsInvariant(static_cast<NodeOneOP*>(node)->first, cost);
+	case typeNodeBinaryOp:
+	case typeNodeArrayIndex:
+		cost++;
+		return IsInvariant(static_cast<NodeTwoOP*>(node)->first, cost) && IsInvariant(static_cast<NodeTwoOP*>(node)->second, cost);
+	case typeNodeFuncCall:
+		if(!IsPureCall(node))
+			return false;
+		cost += 4;
+		for(NodeZeroOP *curr = static_cast<NodeFuncCall*>(node)->paramHead; curr; curr = curr->next)
+		{
+			if(!IsInvariant(curr, cost))
+				return false;
+		}
+		return true;
+	default:
+		break;
+	}
+	return false;
+}
+
+// Replace invariant parts of an expression that is evaluated on every loop iteration with loads of hidden variables
+void TreeOptimizer::HoistFromCondition(NodeZeroOP *&node)
+{
+	unsigned int cost = 0;
+
+	TypeInfo *type = node->typeInfo;
+	if(IsReusableType(type) && IsInvariant(node, cost) && cost >= 2)
+	{
+		VariableInfo *temporary = createTemporary(type);
+
+		// Value is computed once before the loop
+		nodeList.push_back(node);
+		nodeList.push_back(new NodeGetAddress(temporary, temporary->pos, temporary->varType));
+		nodeList.push_back(new NodeVariableSet(CodeInfo::GetReferenceType(temporary->varType), true, false));
+		nodeList.push_back(new NodePopOp());
+		hoistedList.push_back(TakeLastNode());
+
+		nodeList.push_back(new NodeGetAddress(temporary, temporary->pos, temporary->varType));
+		node = new NodeDereference();
+
+		optimizedCount++;
+		return;
+	}
+
+	switch(node->nodeType)
+	{
+	case typeNodeBinaryOp:
+		HoistFromCondition(static_cast<NodeTwoOP*>(node)->first);
+		// Right side of logical operators is not always evaluated
+		if(static_cast<NodeBinaryOp*>(node)->cmdID != cmdLogAnd && static_cast<NodeBinaryOp*>(node)->cmdID != cmdLogOr)
+			HoistFromCondition(static_cast<NodeTwoOP*>(node)->second);
+		break;
+	case typeNodeArrayIndex:
+		HoistFromCondition(static_cast<NodeTwoOP*>(node)->first);
+		HoistFromCondition(static_cast<NodeTwoOP*>(node)->second);
+		break;
+	case typeNodeDereference:
+		if(!GetAccessAddress(node) || GetLocalTarget(GetAccessAddress(node)) || static_cast<NodeDereference*>(node)->knownAddress)
+			break;
+		// fall through
+	case typeNodeUnaryOp:
+	case typeNodeShiftAddress:
+	case typeNodeConvertPtr:
+		if(!node->head)
+			HoistFromCondition(static_cast<NodeOneOP*>(node)->first);
+		break;
+	default:
+		break;
+	}
+}
+
+bool TreeOptimizer::OptimizeLoops(NodeZeroOP *node)
+{
+	// Inner loops are optimized first
+	if(!VisitChildren(node, OptimizeLoops))
+		return false;
+
+	if(node->nodeType != typeNodeForExpr && node->nodeType != typeNodeWhileExpr)
+		return true;
+
+	NodeZeroOP *&condition = node->nodeType == typeNodeForExpr ? static_cast<NodeForExpr*>(node)->second : static_cast<NodeWhileExpr*>(node)->first;
+
+	// Condition must not have side effects, so that hoisted expressions are evaluated in the same order
+	writtenVars.clear();
+	memoryWrite = false;
+	if(!CollectEffects(condition))
+		return false;
+	if(writtenVars.size() || memoryWrite)
+		return true;
+
+	if(node->nodeType == typeNodeForExpr)
+	{
+		if(!CollectEffects(static_cast<NodeForExpr*>(node)->third) || !CollectEffects(static_cast<NodeForExpr*>(node)->fourth))
+			return false;
+	}else{
+		if(!CollectEffects(static_cast<NodeWhileExpr*>(node)->second))
+			return false;
+	}
+
+	hoistedList.clear();
+	HoistFromCondition(condition);
+
+	if(!hoistedList.size())
+		return true;
+
+	if(node->nodeType == typeNodeForExpr)
+	{
+		// Values are computed after the loop initialization
+		nodeList.push_back(static_cast<NodeForExpr*>(node)->first);
+		NodeExpressionList *init = new NodeExpressionList();
+		for(unsigned int i = 0; i < hoistedList.size(); i++)
+		{
+			nodeList.push_back(hoistedList[i]);
+			init->AddNode(false);
+		}
+		static_cast<NodeForExpr*>(node)->first = init;
+	}else{
+		for(unsigned int i = 0; i < hoistedList.size(); i++)
+		{
+			nodeList.push_back(hoistedList[i]);
+			node->AddExtraNode();
+		}
+	}
+
+	return true;
+}
+
+unsigned int TreeOptimizer::HoistLoopInvariants(FunctionInfo *func, NodeZeroOP *body, CreateTemporary createTemp, bool reuseCalls)
+{
+	// Coroutine locals are stored in a closure
+	if(func->type == FunctionInfo::COROUTINE)
+		return 0;
+
+	createTemporary = createTemp;
+	pureCalls = reuseCalls;
+	optimizedCount = 0;
+
+	escapedVars.clear();
+	if(!FindEscapes(body))
+		return 0;
+
+	OptimizeLoops(body);
+
+	return optimizedCount;
+}
+
+bool TreeOptimizer::IsEqual(NodeZeroOP *a, NodeZeroOP *b)
+{
+	if(a->nodeType != b->nodeType || a->typeInfo != b->typeInfo || a->head || b->head)
+		return false;
+
+	switch(a->nodeType)
+	{
+	case typeNodeNumber:
+		if(a->typeInfo == typeDouble || a->typeInfo == typeFloat)
+			return memcmp(&static_cast<NodeNumber*>(a)->num.real, &static_cast<NodeNumber*>(b)->num.real, sizeof(double)) == 0;
+		return static_cast<NodeNumber*>(a)->GetLong() == static_cast<NodeNumber*>(b)->GetLong();
+	case typeNodeGetAddress:
+		return static_cast<NodeGetAddress*>(a)->varInfo == static_cast<NodeGetAddress*>(b)->varInfo && static_cast<NodeGetAddress*>(a)->varAddress == static_cast<NodeGetAddress*>(b)->varAddress;
+	case typeNodeDereference:
+	{
+		NodeDereference *derefA = static_cast<NodeDereference*>(a), *derefB = static_cast<NodeDereference*>(b);
+		if(derefA->addrShift != derefB->addrShift || derefA->knownAddress != derefB->knownAddress || derefA->absAddress != derefB->absAddress)
+			return false;
+		return IsEqual(derefA->first, derefB->first);
+	}
+	case typeNodeShiftAddress:
+		if(static_cast<NodeShiftAddress*>(a)->memberShift != static_cast<NodeShiftAddress*>(b)->memberShift)
+			return false;
+		return IsEqual(static_cast<NodeOneOP*>(a)->first, static_cast<NodeOneOP*>(b)->first);
+	case typeNodeConvertPtr:
+		if(static_cast<NodeConvertPtr*>(a)->handleBaseClass != static_cast<NodeConvertPtr*>(b)->handleBaseClass)
+			return false;
+		return IsEqual(static_cast<NodeOneOP*>(a)->first, static_cast<NodeOneOP*>(b)->first);
+	case typeNodeUnaryOp:
+		if(static_cast<NodeUnaryOp*>(a)->vmCmd.cmd != static_cast<NodeUnaryOp*>(b)->vmCmd.cmd || static_cast<NodeUnaryOp*>(a)->vmCmd.argument != static_cast<NodeUnaryOp*>(b)->vmCmd.argument)
+			return false;
+		return IsEqual(static_cast<NodeOneOP*>(a)->first, static_cast<NodeOneOP*>(b)->first);
+	case typeNodeBinaryOp:
+		if(static_cast<NodeBinaryOp*>(a)->cmdID != static_cast<NodeBinaryOp*>(b)->cmdID)
+			return false;
+		return IsEqual(static_cast<NodeTwoOP*>(a)->first, static_cast<NodeTwoOP*>(b)->first) && IsEqual(static_cast<NodeTwoOP*>(a)->second, static_cast<NodeTwoOP*>(b)->second);
+	case typeNodeArrayIndex:
+		if(static_cast<NodeArrayIndex*>(a)->knownShift != static_cast<NodeArrayIndex*>(b)->knownShift || static_cast<NodeArrayIndex*>(a)->shiftValue != static_cast<NodeArrayIndex*>(b)->shiftValue)
+			return false;
+		return IsEqual(static_cast<NodeTwoOP*>(a)->first, static_cast<NodeTwoOP*>(b)->first) && IsEqual(static_cast<NodeTwoOP*>(a)->second, static_cast<NodeTwoOP*>(b)->second);
+	case typeNodeFuncCall:
+	{
+		if(static_cast<NodeFuncCall*>(a)->funcInfo != static_cast<NodeFuncCall*>(b)->funcInfo)
+			return false;
+		NodeZeroOP *currA = static_cast<NodeFuncCall*>(a)->paramHead, *currB = static_cast<NodeFuncCall*>(b)->paramHead;
+		for(; currA && currB; currA = currA->next, currB = currB->next)
+		{
+			if(!IsEqual(currA, currB))
+				return false;
+		}
+		return !currA && !currB;
+	}
+	default:
+		break;
+	}
+	return false;
+}
+
+// Temporary variables can be shared between different expressions
+VariableInfo* TreeOptimizer::GetRegionTemporary(TypeInfo *type)
+{
+	for(unsigned int i = 0; i < temporaryList.size(); i++)
+	{
+		if(temporaryList[i]->varType == type && temporaryRegion[i] != regionIndex)
+		{
+			temporaryRegion[i] = regionIndex;
+			return temporaryList[i];
+		}
+	}
+
+	temporaryList.push_back(createTemporary(type));
+	temporaryRegion.push_back(regionIndex);
+	return temporaryList.back();
+}
+
+// Replace subexpressions with values that were computed earlier in the same expression
+void TreeOptimizer::ReuseValues(NodeZeroOP *&node)
+{
+	unsigned int cost = 0;
+	bool reusable = IsReusableType(node->typeInfo) && IsInvariant(node, cost) && cost >= 2;
+
+	if(reusable)
+	{
+		for(unsigned int i = 0; i < availableList.size(); i++)
+		{
+			AvailableValue &value = availableList[i];
+			if(!IsEqual(value.node, node))
+				continue;
+
+			// First computation of the value is saved to a temporary variable
+			if(!value.temporary)
+			{
+				value.temporary = GetRegionTemporary(node->typeInfo);
+
+				nodeList.push_back(value.node);
+				nodeList.push_back(new NodeGetAddress(value.temporary, value.temporary->pos, value.temporary->varType));
+				*value.slot = new NodeVariableSet(CodeInfo::GetReferenceType(value.temporary->varType), true, false);
+			}
+
+			nodeList.push_back(new NodeGetAddress(value.temporary, value.temporary->pos, value.temporary->varType));
+			node = new NodeDereference();
+
+			optimizedCount++;
+			return;
+		}
+	}
+
+	// Child nodes are visited in the order of evaluation
+	switch(node->nodeType)
+	{
+	case typeNodeBinaryOp:
+		ReuseValues(static_cast<NodeTwoOP*>(node)->first);
+		if(static_cast<NodeBinaryOp*>(node)->cmdID == cmdLogAnd || static_cast<NodeBinaryOp*>(node)->cmdID == cmdLogOr)
+		{
+			// Values computed on the right side of logical operators are not always available
+			unsigned int availableCount = availableList.size();
+			ReuseValues(static_cast<NodeTwoOP*>(node)->second);
+			availableList.shrink(availableCount);
+		}else{
+			ReuseValues(static_cast<NodeTwoOP*>(node)->second);
+		}
+		break;
+	case typeNodeArrayIndex:
+		ReuseValues(static_cast<NodeTwoOP*>(node)->first);
+		ReuseValues(static_cast<NodeTwoOP*>(node)->second);
+		break;
+	case typeNodeDereference:
+		if(static_cast<NodeDereference*>(node)->knownAddress)
+			break;
+		// fall through
+	case typeNodeUnaryOp:
+	case typeNodeShiftAddress:
+	case typeNodeConvertPtr:
+		ReuseValues(static_cast<NodeOneOP*>(node)->first);
+		break;
+	default:
+		break;
+	}
+
+	if(reusable)
+	{
+		availableList.push_back();
+		availableList.back().slot = &node;
+		availableList.back().node = node;
+		availableList.back().temporary = NULL;
+	}
+}
+
+// Find expressions without side effects
+bool TreeOptimizer::FindRegions(NodeZeroOP *node)
+{
+	unsigned int cost = 0;
+	if(!IsInvariant(node, cost))
+		return VisitChildren(node, FindRegions);
+
+	// At least two subexpressions are required
+	if(cost >= 4)
+	{
+		regionIndex++;
+
+		// Root of the expression is not replaced
+		NodeZeroOP *root = node;
+		ReuseValues(root);
+		assert(root == node);
+
+		availableList.clear();
+	}
+	return true;
+}
+
+unsigned int TreeOptimizer::EliminateCommonSubexpressions(NodeZeroOP *code, CreateTemporary createTemp, bool reuseCalls)
+{
+	createTemporary = createTemp;
+	pureCalls = reuseCalls;
+	optimizedCount = 0;
+
+	// Without any side effects in the loop, all expressions are invariant
+	writtenVars.clear();
+	memoryWrite = false;
+
+	availableList.clear();
+	temporaryList.clear();
+	temporaryRegion.clear();
+
+	FindRegions(code);
+
+	return optimizedCount;
+}
+
+bool TreeOptimizer::IsRead(VariableInfo *variable)
+{
+	for(unsigned int i = 0; i < readVars.size(); i++)
+	{
+		if(readVars[i] == variable)
+			return true;
+	}
+	return false;
+}
+
+// Check if expression has no side effects and cannot raise a runtime error
+bool TreeOptimizer::CanRemove(NodeZeroOP *node)
+{
+	if(node->head)
+		return false;
+
+	switch(node->nodeType)
+	{
+	case typeNodeNumber:
+	case typeNodeGetAddress:
+		return true;
+	case typeNodeDereference:
+		// Only a load from a known address can't fail
+		return GetAccessAddress(node) && GetAccessAddress(node)->nodeType == typeNodeGetAddress;
+	case typeNodeShiftAddress:
+		return CanRemove(static_cast<NodeOneOP*>(node)->first);
+	case typeNodeUnaryOp:
+		if(static_cast<NodeUnaryOp*>(node)->vmCmd.cmd == cmdCheckedRet || static_cast<NodeUnaryOp*>(node)->vmCmd.cmd == cmdFuncAddr)
+			return false;
+		return CanRemove(static_cast<NodeOneOP*>(node)->first);
+	case typeNodeBinaryOp:
+		// Integer division by zero is a runtime error
+		if(static_cast<NodeBinaryOp*>(node)->cmdID == cmdDiv || static_cast<NodeBinaryOp*>(node)->cmdID == cmdMod)
+			return false;
+		return CanRemove(static_cast<NodeTwoOP*>(node)->first) && CanRemove(static_cast<NodeTwoOP*>(node)->second);
+	case typeNodeFuncCall:
+		// Pure function can still fail on division by zero or an index out of bounds
+		if(!IsPureCall(node) || !static_cast<NodeFuncCall*>(node)->funcInfo->trapFree)
+			return false;
+		for(NodeZeroOP *curr = static_cast<NodeFuncCall*>(node)->paramHead; curr; curr = curr->next)
+		{
+			if(!CanRemove(curr))
+				return false;
+		}
+		return true;
+	default:
+		break;
+	}
+	return false;
+}
+
+// Loops are rejected, because the function might not return
+bool TreeOptimizer::IsTrapFree(NodeZeroOP *node)
+{
+	switch(node->nodeType)
+	{
+	case typeNodeZeroOp:
+	case typeNodeNumber:
+	case typeNodeGetAddress:
+	case typeNodeShiftAddress:
+	case typeNodePopOp:
+	case typeNodeIfElseExpr:
+	case typeNodeExpressionList:
+		break;
+	case typeNodeReturnOp:
+		if(static_cast<NodeReturnOp*>(node)->yieldResult)
+			return false;
+		break;
+	case typeNodeDereference:
+	case typeNodeVariableSet:
+	case typeNodePreOrPostOp:
+		if(!GetAccessAddress(node) || GetAccessAddress(node)->nodeType != typeNodeGetAddress)
+			return false;
+		break;
+	case typeNodeVariableModify:
+		if(!GetAccessAddress(node) || GetAccessAddress(node)->nodeType != typeNodeGetAddress)
+			return false;
+		if(static_cast<NodeVariableModify*>(node)->cmdID == cmdDiv || static_cast<NodeVariableModify*>(node)->cmdID == cmdMod)
+			return false;
+		break;
+	case typeNodeUnaryOp:
+		if(static_cast<NodeUnaryOp*>(node)->vmCmd.cmd == cmdCheckedRet || static_cast<NodeUnaryOp*>(node)->vmCmd.cmd == cmdFuncAddr)
+			return false;
+		break;
+	case typeNodeBinaryOp:
+		if(static_cast<NodeBinaryOp*>(node)->cmdID == cmdDiv || static_cast<NodeBinaryOp*>(node)->cmdID == cmdMod)
+			return false;
+		break;
+	case typeNodeFuncCall:
+		// Function that is being checked isn't trap-free yet, so recursive calls are rejected
+		if(!static_cast<NodeFuncCall*>(node)->funcInfo || !static_cast<NodeFuncCall*>(node)->funcInfo->trapFree || static_cast<NodeFuncCall*>(node)->first)
+			return false;
+		break;
+	default:
+		return false;
+	}
+
+	return VisitChildren(node, IsTrapFree);
+}
+
+// Unknown nodes are treated as if they contain a function definition
+bool TreeOptimizer::NoFunctionDefinitions(NodeZeroOP *node)
+{
+	if(node->nodeType == typeNodeFuncDef)
+		return false;
+	return VisitChildren(node, NoFunctionDefinitions);
+}
+
+// Find local variables whose value is used
+bool TreeOptimizer::CollectReads(NodeZeroOP *node)
+{
+	switch(node->nodeType)
+	{
+	case typeNodeDereference:
+	case typeNodeVariableModify:
+	case typeNodePreOrPostOp:
+		if(VariableInfo *target = GetLocalTarget(GetAccessAddress(node)))
+		{
+			if(!IsRead(target))
+				readVars.push_back(target);
+		}
+		break;
+	default:
+		break;
+	}
+
+	return VisitChildren(node, CollectReads);
+}
+
+bool TreeOptimizer::RemoveDead(NodeZeroOP *node)
+{
+	if(node->nodeType == typeNodeExpressionList && node->typeInfo == typeVoid)
+	{
+		NodeExpressionList *list = static_cast<NodeExpressionList*>(node);
+
+		// Statements after a jump out of the block are never executed
+		for(NodeZeroOP *curr = list->first; curr && curr->next; curr = curr->next)
+		{
+			bool isJump = curr->nodeType == typeNodeBreakOp || curr->nodeType == typeNodeContinueOp;
+			if(curr->nodeType == typeNodeReturnOp && !static_cast<NodeReturnOp*>(curr)->yieldResult)
+				isJump = true;
+			if(!isJump)
+				continue;
+
+			bool removable = true;
+			for(NodeZeroOP *rest = curr->next; rest && removable; rest = rest->next)
+				removable = NoFunctionDefinitions(rest);
+			if(removable)
+			{
+				curr->next = NULL;
+				list->tail = curr;
+				optimizedCount++;
+			}
+			break;
+		}
+	}else if(node->nodeType == typeNodePopOp){
+		NodeOneOP *pop = static_cast<NodeOneOP*>(node);
+
+		if(pop->first->nodeType == typeNodeVariableSet && !pop->first->head)
+		{
+			NodeVariableSet *assignment = static_cast<NodeVariableSet*>(pop->first);
+
+			// Value stored to a local variable that is never read is only computed for its side effects
+			VariableInfo *target = GetLocalTarget(GetAccessAddress(assignment));
+			if(target && !IsEscaped(target) && !IsRead(target) && !GetAccessAddress(assignment)->head)
+			{
+				pop->first = assignment->second;
+				optimizedCount++;
+			}
+		}
+		if(pop->first->nodeType != typeNodeNumber && CanRemove(pop->first))
+		{
+			pop->first = new NodeNumber(0, typeInt);
+			optimizedCount++;
+		}
+	}
+
+	return VisitChildren(node, RemoveDead);
+}
+
+unsigned int TreeOptimizer::RemoveDeadCode(FunctionInfo *func, NodeZeroOP *body, bool reuseCalls)
+{
+	// Coroutine locals are stored in a closure
+	if(func->type == FunctionInfo::COROUTINE)
+		return 0;
+
+	pureCalls = reuseCalls;
+	optimizedCount = 0;
+
+	escapedVars.clear();
+	if(!FindEscapes(body))
+		return 0;
+
+	readVars.clear();
+	if(!CollectReads(body))
+		return 0;
+
+	RemoveDead(body);
+
+	return optimizedCount;
+}
+
+unsigned int TreeOptimizer::CountOf(FastVector<VariableInfo*> &list, VariableInfo *variable)
+{
+	unsigned int count = 0;
+	for(unsigned int i = 0; i < list.size(); i++)
+	{
+		if(list[i] == variable)
+			count++;
+	}
+	return count;
+}
+
+// Collect writes to local variables, loads of their values and loads that are only used as an address of a memory access
+bool TreeOptimizer::CollectPointerUses(NodeZeroOP *node)
+{
+	if(NodeZeroOP *address = GetAccessAddress(node))
+	{
+		VariableInfo *target = GetLocalTarget(address);
+
+		if(target && node->nodeType != typeNodeDereference)
+		{
+			writtenVars.push_back(target);
+
+			NodeZeroOP *value = node->nodeType == typeNodeVariableSet ? static_cast<NodeTwoOP*>(node)->second : NULL;
+			if(value && value->nodeType == typeNodeFuncCall && !value->head && !node->head && !address->head)
+			{
+				static unsigned int hashNewS = GetStringHash("__newS");
+
+				NodeFuncCall *call = static_cast<NodeFuncCall*>(value);
+				if(call->funcInfo && call->funcInfo->nameHash == hashNewS)
+				{
+					Allocation allocation = { static_cast<NodeVariableSet*>(node), target, loopDepth != 0 };
+					allocationList.push_back(allocation);
+				}
+			}
+		}else if(target){
+			readVars.push_back(target);
+		}
+
+		// Member and element addresses are computed from the pointer value without exposing it
+		while(address->nodeType == typeNodeShiftAddress || address->nodeType == typeNodeArrayIndex)
+			address = static_cast<NodeOneOP*>(address)->first;
+
+		if(VariableInfo *pointer = GetLocalTarget(GetAccessAddress(address)))
+		{
+			if(address->nodeType == typeNodeDereference)
+				accessVars.push_back(pointer);
+		}
+	}
+
+	bool isLoop = node->nodeType == typeNodeForExpr || node->nodeType == typeNodeWhileExpr || node->nodeType == typeNodeDoWhileExpr;
+
+	if(isLoop)
+		loopDepth++;
+	bool result = VisitChildren(node, CollectPointerUses);
+	if(isLoop)
+		loopDepth--;
+
+	return result;
+}
+
+unsigned int TreeOptimizer::AllocateOnStack(FunctionInfo *func, NodeZeroOP *body, CreateTemporary createTemp)
+{
+	// Coroutine locals are stored in a closure
+	if(func->type == FunctionInfo::COROUTINE)
+		return 0;
+
+	// Larger objects would make the stack frame too big
+	const unsigned int maxObjectSize = 256;
+
+	optimizedCount = 0;
+
+	escapedVars.clear();
+	if(!FindEscapes(body))
+		return 0;
+
+	// Every access is recorded, not only unique variables
+	writtenVars.clear();
+	readVars.clear();
+	accessVars.clear();
+	allocationList.clear();
+	loopDepth = 0;
+	if(!CollectPointerUses(body))
+		return 0;
+
+	for(unsigned int i = 0; i < allocationList.size(); i++)
+	{
+		Allocation &allocation = allocationList[i];
+		VariableInfo *pointer = allocation.pointer;
+
+		// Pointer must hold only this object and its value must not be copied anywhere
+		if(IsEscaped(pointer) || CountOf(writtenVars, pointer) != 1 || CountOf(readVars, pointer) != CountOf(accessVars, pointer))
+			continue;
+
+		TypeInfo *type = allocation.node->second->typeInfo->subType;
+		if(!type || !type->hasFinished || type->hasFinalizer || type->size > maxObjectSize)
+			continue;
+
+		// Stack frame is cleared on function entry, but a loop has to clear the object on every iteration
+		VariableInfo *object = createTemp(type);
+
+		NodeZeroOP *address = new NodeGetAddress(object, object->pos, object->varType);
+		if(allocation.inLoop)
+		{
+			VariableInfo *empty = createTemp(type);
+
+			nodeList.push_back(new NodeGetAddress(empty, empty->pos, empty->varType));
+			nodeList.push_back(new NodeDereference());
+			nodeList.push_back(new NodeGetAddress(object, object->pos, object->varType));
+			nodeList.push_back(new NodeVariableSet(CodeInfo::GetReferenceType(object->varType), true, false));
+			nodeList.push_back(new NodePopOp());
+			address->AddExtraNode();
+		}
+		allocation.node->second = address;
+
+		optimizedCount++;
+	}
+
+	return optimizedCount;
+}
+
+// Get address node if expression is a load from a variable or its member
+NodeGetAddress* TreeOptimizer::GetLoadAddress(NodeZeroOP *node)
+{
+	if(node->nodeType != typeNodeDereference || node->head || !GetAccessAddress(node))
+		return NULL;
+
+	NodeZeroOP *original = static_cast<NodeDereference*>(node)->originalNode;
+	if(original->nodeType != typeNodeGetAddress || original->head || static_cast<NodeGetAddress*>(original)->trackAddress)
+		return NULL;
+	return static_cast<NodeGetAddress*>(original);
+}
+
+// Check that node stores a non-negative integer number to a local variable
+bool TreeOptimizer::IsNonNegativeStore(NodeZeroOP *node, VariableInfo *variable)
+{
+	if(node->nodeType == typeNodePopOp && !node->head)
+		node = static_cast<NodeOneOP*>(node)->first;
+
+	if(node->nodeType != typeNodeVariableSet || node->head || GetLocalTarget(GetAccessAddress(node)) != variable)
+		return false;
+
+	NodeZeroOP *value = static_cast<NodeTwoOP*>(node)->second;
+	return value->nodeType == typeNodeNumber && !value->head && value->typeInfo == typeInt && static_cast<NodeNumber*>(value)->GetInteger() >= 0;
+}
+
+// Mark indexing of the loop array by the loop counter
+bool TreeOptimizer::MarkIndexInBounds(NodeZeroOP *node)
+{
+	if(node->nodeType == typeNodeArrayIndex && !node->head)
+	{
+		NodeArrayIndex *index = static_cast<NodeArrayIndex*>(node);
+		NodeZeroOP *value = index->second;
+
+		if(!index->knownShift && value->nodeType == typeNodeDereference && !value->head && GetLocalTarget(GetAccessAddress(value)) == loopCounter)
+		{
+			bool inBounds = false;
+			if(loopSize)
+			{
+				// Array is loaded from the place where the size checked by the loop condition is stored
+				NodeGetAddress *array = GetLoadAddress(index->first);
+				if(array && index->typeParent->arrSize == TypeInfo::UNSIZED_ARRAY && array->typeOrig == index->typeParent && array->varInfo == loopSize->varInfo)
+					inBounds = array->varAddress + (int)index->typeParent->firstVariable->offset == loopSize->varAddress;
+			}else{
+				// Any array with a known size that is not smaller than the loop bound
+				inBounds = index->typeParent->arrSize != TypeInfo::UNSIZED_ARRAY && loopBound <= index->typeParent->arrSize;
+			}
+
+			if(inBounds && !index->uncheckedIndex)
+			{
+				index->uncheckedIndex = true;
+				optimizedCount++;
+			}
+		}
+	}
+
+	return VisitChildren(node, MarkIndexInBounds);
+}
+
+bool TreeOptimizer::FindCountedLoops(NodeZeroOP *node)
+{
+	if(!VisitChildren(node, FindCountedLoops))
+		return false;
+
+	if(node->nodeType != typeNodeForExpr)
+		return true;
+
+	NodeForExpr *loop = static_cast<NodeForExpr*>(node);
+
+	// Condition is 'i < bound'
+	NodeZeroOP *condition = loop->second;
+	if(condition->nodeType != typeNodeBinaryOp || condition->head || static_cast<NodeBinaryOp*>(condition)->cmdID != cmdLess)
+		return true;
+
+	NodeZeroOP *counter = static_cast<NodeBinaryOp*>(condition)->first;
+	NodeZeroOP *bound = static_cast<NodeBinaryOp*>(condition)->second;
+
+	if(counter->nodeType != typeNodeDereference || counter->head)
+		return true;
+
+	VariableInfo *variable = GetLocalTarget(GetAccessAddress(counter));
+	if(!variable || variable->varType != typeInt || IsEscaped(variable))
+		return true;
+
+	// Counter starts from a non-negative value and is only incremented by one after each iteration, so it can't overflow before reaching the bound
+	if(!IsNonNegativeStore(loop->first, variable))
+		return true;
+
+	NodeZeroOP *step = loop->third;
+	if(step->nodeType == typeNodePopOp && !step->head)
+		step = static_cast<NodeOneOP*>(step)->first;
+	if(step->nodeType != typeNodePreOrPostOp || step->head || !static_cast<NodePreOrPostOp*>(step)->incOp || GetLocalTarget(GetAccessAddress(step)) != variable)
+		return true;
+
+	// Loop body must not modify the counter
+	writtenVars.clear();
+	memoryWrite = false;
+	if(!CollectEffects(loop->fourth))
+		return false;
+	if(IsWritten(variable))
+		return true;
+
+	// Bound must not change during loop execution
+	if(!CollectEffects(step))
+		return false;
+
+	unsigned int cost = 0;
+	if(!IsInvariant(bound, cost))
+		return true;
+
+	if(bound->nodeType == typeNodeNumber && bound->typeInfo == typeInt)
+	{
+		int value = static_cast<NodeNumber*>(bound)->GetInteger();
+
+		loopSize = NULL;
+		loopBound = value < 0 ? 0 : (unsigned int)value;
+	}else if(NodeGetAddress *size = GetLoadAddress(bound)){
+		// Matched with the size member of an unsized array when indexing
+		if(size->typeOrig != typeInt)
+			return true;
+
+		loopSize = size;
+		loopBound = 0;
+	}else{
+		return true;
+	}
+
+	loopCounter = variable;
+
+	return MarkIndexInBounds(loop->fourth);
+}
+
+unsigned int TreeOptimizer::RemoveBoundsChecks(FunctionInfo *func, NodeZeroOP *body, bool reuseCalls)
+{
+	// Coroutine locals are stored in a closure
+	if(func->type == FunctionInfo::COROUTINE)
+		return 0;
+
+	pureCalls = reuseCalls;
+	optimizedCount = 0;
+
+	escapedVars.clear();
+	if(!FindEscapes(body))
+		return 0;
+
+	FindCountedLoops(body);
+
+	return optimizedCount;
+}
+
 void ResetTreeGlobals()
 {
 	currLoopDepth = 0;
@@ -2127,4 +3388,14 @@ void ResetTreeGlobals()
 	NodeContinueOp::fixQueue.clear();
 	NodeFuncCall::memoList.clear();
 	NodeFuncCall::memoPool.Clear();
+
+	TreeOptimizer::escapedVars.clear();
+	TreeOptimizer::writtenVars.clear();
+	TreeOptimizer::readVars.clear();
+	TreeOptimizer::hoistedList.clear();
+	TreeOptimizer::availableList.clear();
+	TreeOptimizer::temporaryList.clear();
+	TreeOptimizer::temporaryRegion.clear();
+	TreeOptimizer::allocationList.clear();
+	TreeOptimizer::accessVars.clear();
 }
@@ -110,6 +110,7 @@ public:
 
 	void*		operator new(size_t size)
 	{
+		createdNodes++;
 		return nodePool.Allocate((unsigned int)size);
 	}
 	void		operator delete(void *ptr, size_t size)
@@ -119,8 +120,10 @@ public:
 
 	static	ChunkedStackPool<65532>	nodePool;
 	static void	DeleteNodes(){ nodePool.Clear(); }
-	static void	ResetNodes(){ nodePool.~ChunkedStackPool(); }
+	static void	ResetNodes(){ nodePool.Reset(); }
 public:
+	static unsigned int	createdNodes;
+
 	const char		*sourcePos;
 
 	TypeInfo		*typeInfo;
@@ -152,6 +155,8 @@ public:
 			typeInfo = first->typeInfo;
 	}
 protected:
+	friend class TreeOptimizer;
+
 	NodeZeroOP*	first;
 };
 
@@ -166,6 +171,8 @@ public:
 
 	NodeZeroOP*	GetSecondNode(){ return second; }
 protected:
+	friend class TreeOptimizer;
+
 	NodeZeroOP*	second;
 };
 
@@ -180,6 +187,8 @@ public:
 
 	NodeZeroOP*	GetTrirdNode(){ return third; }
 protected:
+	friend class TreeOptimizer;
+
 	NodeZeroOP*	third;
 };
 
@@ -285,6 +294,9 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class NodeFuncCall;
+	friend class TreeOptimizer;
+
 	VMCmd vmCmd;
 	FunctionInfo *parentFunc;
 };
@@ -301,6 +313,8 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	bool			localReturn;
 	bool			yieldResult;
 	FunctionInfo	*parentFunction;
@@ -369,6 +383,8 @@ protected:
 	friend class NodePreOrPostOp;
 	friend class NodeFunctionAddress;
 	friend class NodeReturnOp;
+	friend class NodeFuncCall;
+	friend class TreeOptimizer;
 
 	TypeInfo		*typeOrig;
 	VariableInfo	*varInfo;
@@ -402,6 +418,8 @@ public:
 	COMPILE_TRANSLATION(virtual void TranslateToC(FILE *fOut));
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	bool	handleBaseClass;
 };
 
@@ -417,6 +435,8 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	unsigned int	elemCount;	// If node sets all array, here is the element count
 	int		addrShift;
 	bool	absAddress, knownAddress, arrSetAll;
@@ -434,6 +454,8 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	CmdID	cmdID;
 	int		addrShift;
 	bool	absAddress, knownAddress;
@@ -453,6 +475,9 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 private:
+	friend class NodeFuncCall;
+	friend class TreeOptimizer;
+
 	int		addrShift;
 	bool	absAddress, knownAddress, neutralized, readonly;
 	FunctionInfo	*closureFunc;
@@ -481,6 +506,7 @@ public:
 	TypeInfo	*typeParent;
 	bool		knownShift;
 	int			shiftValue;
+	bool		uncheckedIndex;	// Index is known to be inside array bounds
 };
 
 class NodeShiftAddress: public NodeOneOP
@@ -498,6 +524,7 @@ protected:
 	friend class NodeVariableSet;
 	friend class NodeVariableModify;
 	friend class NodePreOrPostOp;
+	friend class TreeOptimizer;
 
 	TypeInfo::MemberVariable	*member;
 	unsigned int	memberShift;
@@ -517,6 +544,8 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	bool	incOp;
 	bool	optimised;
 
@@ -553,6 +582,8 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	CmdID cmdID;
 };
 
@@ -582,6 +613,8 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	NodeZeroOP*	fourth;
 };
 
@@ -594,6 +627,7 @@ public:
 	virtual void Compile();
 	virtual void LogToStream(FILE *fGraph);
 	COMPILE_TRANSLATION(virtual void TranslateToC(FILE *fOut));
+	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
 };
@@ -607,6 +641,7 @@ public:
 	virtual void Compile();
 	virtual void LogToStream(FILE *fGraph);
 	COMPILE_TRANSLATION(virtual void TranslateToC(FILE *fOut));
+	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
 };
@@ -620,6 +655,7 @@ public:
 	virtual void Compile();
 	virtual void LogToStream(FILE *fGraph);
 	COMPILE_TRANSLATION(virtual void TranslateToC(FILE *fOut));
+	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 
 	static	void SatisfyJumps(unsigned int pos);
@@ -637,6 +673,7 @@ public:
 	virtual void Compile();
 	virtual void LogToStream(FILE *fGraph);
 	COMPILE_TRANSLATION(virtual void TranslateToC(FILE *fOut));
+	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 
 	static	void SatisfyJumps(unsigned int pos);
@@ -662,6 +699,8 @@ public:
 
 	static FastVector<unsigned int>	fixQueue;
 protected:
+	friend class TreeOptimizer;
+
 	NodeZeroOP	*conditionHead, *conditionTail;
 	NodeZeroOP	*blockHead, *blockTail;
 	NodeZeroOP	*defaultCase;
@@ -684,6 +723,8 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 protected:
+	friend class TreeOptimizer;
+
 	NodeZeroOP	*tail;
 };
 
@@ -699,7 +740,9 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 
-	static unsigned int callCount;
+	// Number of calls and loop iterations performed by compile-time evaluation and their limit
+	static unsigned int stepCount;
+	static unsigned int stepLimit;
 	static unsigned int baseShift;
 	static ChunkedStackPool<4092>	memoPool;
 	struct CallMemo
@@ -709,11 +752,26 @@ public:
 		char			*arguments;
 	};
 	static FastVector<CallMemo>		memoList;
+
+			void SetInlineFrame(int shift, bool global);
+
+	// Returns function return node if calls to the function can be replaced with the returned expression
+	static NodeZeroOP*	GetInlineReturn(FunctionInfo *func, NodeZeroOP *body, unsigned int nodeLimit);
+	static unsigned int	GetInlineCost(FunctionInfo *func, NodeZeroOP *node);
+
+	// Function that is being inlined and the shift from its stack frame to the hidden variables that hold arguments
+	static FunctionInfo	*inlineFunc;
+	static int			inlineShift;
+	static bool			inlineGlobal;
 public:
 	FunctionInfo	*funcInfo;
 	FunctionType	*funcType;
 
 	NodeZeroOP		*paramHead, *paramTail;
+
+	bool			inlined;
+	int				inlineFrameShift;
+	bool			inlineFrameGlobal;
 };
 
 class NodeFunctionProxy: public NodeOneOP
@@ -799,3 +857,92 @@ public:
 	virtual NodeNumber*	Evaluate(char *memory, unsigned int size);
 	COMPILE_LLVM(virtual void CompileLLVM());
 };
+
+//////////////////////////////////////////////////////////////////////////
+// Optimizations that are performed on a complete function body
+class TreeOptimizer
+{
+public:
+	typedef VariableInfo* (*CreateTemporary)(TypeInfo *type);
+
+	// Hoist loop-invariant parts of 'for' and 'while' loop conditions out of the loop, returns the number of hoisted expressions
+	static unsigned int	HoistLoopInvariants(FunctionInfo *func, NodeZeroOP *body, CreateTemporary createTemp, bool reuseCalls);
+	// Reuse values of repeated subexpressions inside expressions without side effects, returns the number of removed subexpressions
+	static unsigned int	EliminateCommonSubexpressions(NodeZeroOP *code, CreateTemporary createTemp, bool reuseCalls);
+	// Remove unreachable statements, stores to local variables that are never read and unused values without side effects, returns the number of removed nodes
+	static unsigned int	RemoveDeadCode(FunctionInfo *func, NodeZeroOP *body, bool reuseCalls);
+	// Check that function body only changes its local variables and can't raise a runtime error, so that an unused call to it can be removed
+	static bool	IsTrapFree(NodeZeroOP *node);
+	// Place objects allocated with 'new' that are accessed only through a single local pointer in hidden local variables, returns the number of replaced allocations
+	static unsigned int	AllocateOnStack(FunctionInfo *func, NodeZeroOP *body, CreateTemporary createTemp);
+	// Remove bounds checks of 'arr[i]' inside 'for(i = N; i < arr.size; i++)' loops that don't modify 'i' and 'arr', returns the number of unchecked indexing nodes
+	static unsigned int	RemoveBoundsChecks(FunctionInfo *func, NodeZeroOP *body, bool reuseCalls);
+
+	struct AvailableValue
+	{
+		NodeZeroOP		**slot;
+		NodeZeroOP		*node;
+		VariableInfo	*temporary;
+	};
+
+	struct Allocation
+	{
+		NodeVariableSet	*node;
+		VariableInfo	*pointer;
+		bool			inLoop;
+	};
+
+	static FastVector<VariableInfo*>	escapedVars;
+	static FastVector<VariableInfo*>	writtenVars;
+	static FastVector<VariableInfo*>	readVars;
+	static FastVector<NodeZeroOP*>		hoistedList;
+	static FastVector<AvailableValue>	availableList;
+	static FastVector<VariableInfo*>	temporaryList;
+	static FastVector<unsigned int>		temporaryRegion;
+	static FastVector<Allocation>		allocationList;
+	static FastVector<VariableInfo*>	accessVars;
+private:
+	static bool	VisitChildren(NodeZeroOP *node, bool (*visit)(NodeZeroOP*));
+	static NodeZeroOP*		GetAccessAddress(NodeZeroOP *node);
+	static VariableInfo*	GetLocalTarget(NodeZeroOP *address);
+	static bool	IsEscaped(VariableInfo *variable);
+	static bool	IsWritten(VariableInfo *variable);
+	static bool	IsPureCall(NodeZeroOP *node);
+	static bool	IsReusableType(TypeInfo *type);
+
+	static bool	FindEscapes(NodeZeroOP *node);
+	static bool	CollectEffects(NodeZeroOP *node);
+	static bool	IsInvariant(NodeZeroOP *node, unsigned int &cost);
+	static void	HoistFromCondition(NodeZeroOP *&node);
+	static bool	OptimizeLoops(NodeZeroOP *node);
+
+	static bool	IsEqual(NodeZeroOP *a, NodeZeroOP *b);
+	static VariableInfo*	GetRegionTemporary(TypeInfo *type);
+	static void	ReuseValues(NodeZeroOP *&node);
+	static bool	FindRegions(NodeZeroOP *node);
+
+	static bool	IsRead(VariableInfo *variable);
+	static bool	CanRemove(NodeZeroOP *node);
+	static bool	NoFunctionDefinitions(NodeZeroOP *node);
+	static bool	CollectReads(NodeZeroOP *node);
+	static bool	RemoveDead(NodeZeroOP *node);
+
+	static unsigned int	CountOf(FastVector<VariableInfo*> &list, VariableInfo *variable);
+	static bool	CollectPointerUses(NodeZeroOP *node);
+
+	static NodeGetAddress*	GetLoadAddress(NodeZeroOP *node);
+	static bool	IsNonNegativeStore(NodeZeroOP *node, VariableInfo *variable);
+	static bool	MarkIndexInBounds(NodeZeroOP *node);
+	static bool	FindCountedLoops(NodeZeroOP *node);
+
+	static CreateTemporary	createTemporary;
+	static bool				memoryWrite;
+	static bool				pureCalls;
+	static unsigned int		optimizedCount;
+	static unsigned int		regionIndex;
+	static unsigned int		loopDepth;
+
+	static VariableInfo		*loopCounter;
+	static NodeGetAddress	*loopSize;
+	static unsigned int		loopBound;
+};
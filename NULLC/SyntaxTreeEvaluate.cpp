@@ -2,10 +2,18 @@
 #include "CodeInfo.h"
 #include "ConstantFold.h"
 
+// Control flow statements that are being executed
+bool			evaluateReturn = false;
+unsigned int	evaluateBreakDepth = 0;
+unsigned int	evaluateContinueDepth = 0;
+
 NodeNumber* NodeZeroOP::Evaluate(char* memory, unsigned int size)
 {
 	(void)memory;
 	(void)size;
+	// Empty statement
+	if(nodeType == typeNodeZeroOp && typeInfo == typeVoid && !head)
+		return new NodeNumber(0, typeVoid);
 	return NULL;	// by default, node evaluation is unknown
 }
 
@@ -70,6 +78,7 @@ NodeNumber* NodeReturnOp::Evaluate(char *memory, unsigned int size)
 	// Convert it to the return type of the function
 	if(typeInfo)
 		value->ConvertTo(typeInfo);
+	evaluateReturn = true;
 	return value;
 }
 
@@ -93,16 +102,25 @@ NodeNumber* NodeFuncDef::Evaluate(char *memory, unsigned int memSize)
 	// Clear stack frame
 	memset(memory + funcInfo->allParamSize, 0, size - funcInfo->allParamSize);
 
+	// Previous evaluation could have failed inside a loop
+	evaluateReturn = false;
+	evaluateBreakDepth = 0;
+	evaluateContinueDepth = 0;
+
 	unsigned oldBaseShift = NodeFuncCall::baseShift;
 	NodeFuncCall::baseShift = size;
 	// Evaluate function code
 	NodeNumber *result = first->Evaluate(memory, memSize);
 	NodeFuncCall::baseShift = oldBaseShift;
 
+	// Caller continues its execution
+	evaluateReturn = false;
+
 	return result;
 }
 
-unsigned int NodeFuncCall::callCount = 0;
+unsigned int NodeFuncCall::stepCount = 0;
+unsigned int NodeFuncCall::stepLimit = NULLC_DEFAULT_EVALUATION_STEPS;
 unsigned int NodeFuncCall::baseShift = 0;
 ChunkedStackPool<4092> NodeFuncCall::memoPool;
 FastVector<NodeFuncCall::CallMemo> NodeFuncCall::memoList;
@@ -117,8 +135,8 @@ NodeNumber* NodeFuncCall::Evaluate(char *memory, unsigned int size)
 	if(funcInfo->allParamSize > size || funcType->paramCount > 16)
 		return NULL;
 
-	// Limit call count
-	if(callCount++ > 256)
+	// Limit evaluation time
+	if(++stepCount > stepLimit)
 		return NULL;
 
 	unsigned int nextFrameOffset = baseShift;
@@ -366,6 +384,8 @@ NodeNumber* NodeArrayIndex::Evaluate(char *memory, unsigned int size)
 		return new NodeNumber(pointer->GetInteger() + shiftValue, typeInt);
 	}else{
 		NodeNumber *index = second->Evaluate(memory, size);
+		if(!index)
+			return NULL;
 		index->ConvertTo(typeInt);
 		// Check bounds
 		if(index->GetInteger() < 0 || (unsigned int)index->GetInteger() >= typeParent->arrSize)
@@ -591,41 +611,144 @@ NodeNumber* NodeIfElseExpr::Evaluate(char *memory, unsigned int size)
 	return new NodeNumber(0, typeVoid);
 }
 
-unsigned int	evaluateLoopDepth = 0;
+bool IsConditionTrue(NodeNumber *condition)
+{
+	if(condition->typeInfo == typeLong)
+		return condition->GetLong() != 0;
+	return condition->GetInteger() != 0;
+}
+
+// Check if the loop should continue after its body has been evaluated
+bool IsLoopContinued()
+{
+	// Value is returned from the function
+	if(evaluateReturn)
+		return false;
+
+	if(evaluateBreakDepth)
+	{
+		evaluateBreakDepth--;
+		return false;
+	}
+
+	// Continue of an outer loop exits this one
+	if(evaluateContinueDepth)
+	{
+		evaluateContinueDepth--;
+		return evaluateContinueDepth == 0;
+	}
+
+	return true;
+}
 
 NodeNumber* NodeForExpr::Evaluate(char *memory, unsigned int size)
 {
-	if(head || evaluateLoopDepth)
+	if(head)
 		return NULL;
 
 	// Compile initialization node
 	NodeNumber *init = first->Evaluate(memory, size);
 	if(!init)
 		return NULL;
-	
-	NodeNumber *condition = second->Evaluate(memory, size);
-	if(!condition)
-		return NULL;
-	unsigned int iteration = 0;
-	while(condition->GetInteger())
+
+	for(;;)
 	{
-		evaluateLoopDepth++;
+		NodeNumber *condition = second->Evaluate(memory, size);
+		if(!condition)
+			return NULL;
+		if(!IsConditionTrue(condition))
+			break;
+
+		if(++NodeFuncCall::stepCount > NodeFuncCall::stepLimit)
+			return NULL;
+
 		NodeNumber *body = fourth->Evaluate(memory, size);
-		evaluateLoopDepth--;
 		if(!body)
 			return NULL;
+		if(!IsLoopContinued())
+			return evaluateReturn ? body : new NodeNumber(0, typeVoid);
+
 		NodeNumber *increment = third->Evaluate(memory, size);
 		if(!increment)
 			return NULL;
-		condition = second->Evaluate(memory, size);
+	}
+	return new NodeNumber(0, typeVoid);
+}
+
+NodeNumber* NodeWhileExpr::Evaluate(char *memory, unsigned int size)
+{
+	if(head)
+		return NULL;
+
+	for(;;)
+	{
+		NodeNumber *condition = first->Evaluate(memory, size);
 		if(!condition)
 			return NULL;
-		if(iteration++ > 128)
+		if(!IsConditionTrue(condition))
+			break;
+
+		if(++NodeFuncCall::stepCount > NodeFuncCall::stepLimit)
+			return NULL;
+
+		NodeNumber *body = second->Evaluate(memory, size);
+		if(!body)
+			return NULL;
+		if(!IsLoopContinued())
+			return evaluateReturn ? body : new NodeNumber(0, typeVoid);
+	}
+	return new NodeNumber(0, typeVoid);
+}
+
+NodeNumber* NodeDoWhileExpr::Evaluate(char *memory, unsigned int size)
+{
+	if(head)
+		return NULL;
+
+	for(;;)
+	{
+		if(++NodeFuncCall::stepCount > NodeFuncCall::stepLimit)
 			return NULL;
+
+		NodeNumber *body = first->Evaluate(memory, size);
+		if(!body)
+			return NULL;
+		if(!IsLoopContinued())
+			return evaluateReturn ? body : new NodeNumber(0, typeVoid);
+
+		NodeNumber *condition = second->Evaluate(memory, size);
+		if(!condition)
+			return NULL;
+		if(!IsConditionTrue(condition))
+			break;
 	}
 	return new NodeNumber(0, typeVoid);
 }
 
+NodeNumber* NodeBreakOp::Evaluate(char *memory, unsigned int size)
+{
+	(void)memory;
+	(void)size;
+
+	if(head)
+		return NULL;
+
+	evaluateBreakDepth = breakDepth;
+	return new NodeNumber(0, typeVoid);
+}
+
+NodeNumber* NodeContinueOp::Evaluate(char *memory, unsigned int size)
+{
+	(void)memory;
+	(void)size;
+
+	if(head)
+		return NULL;
+
+	evaluateContinueDepth = continueDepth;
+	return new NodeNumber(0, typeVoid);
+}
+
 NodeNumber* NodeExpressionList::Evaluate(char *memory, unsigned int size)
 {
 	if(head)
@@ -640,7 +763,8 @@ NodeNumber* NodeExpressionList::Evaluate(char *memory, unsigned int size)
 		value = curr->Evaluate(memory, size);
 		if(!value)
 			return NULL;
-		if(value && value->typeInfo != typeVoid)
+		// Remaining statements are skipped by 'return', 'break' and 'continue'
+		if(evaluateReturn || evaluateBreakDepth || evaluateContinueDepth)
 			return value;
 		curr = curr->next;
 	}while(curr);
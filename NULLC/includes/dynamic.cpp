@@ -43,6 +43,11 @@ namespace NULLCDynamic
 		}
 		ExternFuncInfo &destFunc = linker->exFunctions[((NULLCFuncPtr*)dest.ptr)->id];
 		ExternFuncInfo &srcFunc = linker->exFunctions[((NULLCFuncPtr*)src.ptr)->id];
+		if(destFunc.isInlined)
+		{
+			nullcThrowError("Function '%s' cannot be overridden, because its calls were inlined", &linker->exSymbols[destFunc.offsetToName]);
+			return;
+		}
 		if(nullcGetCurrentExecutor(NULL) == NULLC_X86)
 			RewriteX86(((NULLCFuncPtr*)dest.ptr)->id, ((NULLCFuncPtr*)src.ptr)->id);
 		destFunc.address = srcFunc.address;
@@ -60,6 +65,11 @@ namespace NULLCDynamic
 			nullcThrowError("Destination variable is not a function");
 			return;
 		}
+		if(linker->exFunctions[((NULLCFuncPtr*)dest.ptr)->id].isInlined)
+		{
+			nullcThrowError("Function '%s' cannot be overridden, because its calls were inlined", &linker->exSymbols[linker->exFunctions[((NULLCFuncPtr*)dest.ptr)->id].offsetToName]);
+			return;
+		}
 
 		char tmp[2048];
 		char *it = tmp;
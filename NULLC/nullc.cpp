@@ -40,6 +40,8 @@ const char*					CodeInfo::lastKnownStartPos = NULL;
 
 Lexeme						*CodeInfo::lexStart = NULL, *CodeInfo::lexFullStart = NULL;
 
+NULLCCompileStatistics		CodeInfo::compileStatistics;
+
 class Executor;
 class ExecutorX86;
 class ExecutorLLVM;
@@ -83,8 +85,10 @@ void	nullcInitCustomAlloc(void* (NCDECL *allocFunc)(int), void (NCDECL *deallocF
 	}
 	nullcLastError = "";
 
-	NULLC::alloc = allocFunc ? allocFunc : NULLC::defaultAlloc;
-	NULLC::dealloc = deallocFunc ? deallocFunc : NULLC::defaultDealloc;
+	NULLC::untrackedAlloc = allocFunc ? allocFunc : NULLC::defaultAlloc;
+	NULLC::untrackedDealloc = deallocFunc ? deallocFunc : NULLC::defaultDealloc;
+	NULLC::alloc = NULLC::untrackedAlloc;
+	NULLC::dealloc = NULLC::untrackedDealloc;
 	NULLC::fileLoad = NULLC::defaultFileLoad;
 
 	CodeInfo::funcInfo.reserve(256);
@@ -209,6 +213,81 @@ nullres nullcLoadModuleBySource(const char* module, const char* code)
 	return 1;
 }
 
+nullres nullcUpdateModuleBySource(const char* module, const char* code)
+{
+	using namespace NULLC;
+	NULLC_CHECK_INITIALIZED(false);
+
+	if(strlen(module) > 512)
+	{
+		nullcLastError = "ERROR: module name is too long";
+		return false;
+	}
+
+	char	path[1024];
+	strcpy(path, module);
+	char	*pos = path;
+	while(*pos)
+		if(*pos++ == '.')
+			pos[-1] = '/';
+	strcat(path, ".nc");
+
+	// Module could have been built from a file in the import path
+	char	fullPath[2048];
+	SafeSprintf(fullPath, 2048, "%s%s", BinaryCache::GetImportPath() ? BinaryCache::GetImportPath() : "", path);
+
+	const char *cachePath = BinaryCache::GetBytecode(path) ? path : fullPath;
+	const char *oldBytecode = BinaryCache::GetBytecode(cachePath);
+	if(!oldBytecode)
+		return nullcLoadModuleBySource(module, code);
+
+	if(strcmp(FindSource((ByteCode*)oldBytecode), code) == 0)
+		return true;
+
+	if(!nullcCompile(code))
+		return false;
+
+	char *bytecode = NULL;
+	nullcGetBytecode(&bytecode);
+
+	// Modules that import this one are relinked to the new code if the interface is the same, otherwise they are rebuilt from their source
+	bool sameInterface = BinaryCache::GetInterfaceHash(oldBytecode) == BinaryCache::GetInterfaceHash(bytecode);
+
+	FastVector<BinaryCache::CodeDescriptor> dependents;
+	BinaryCache::RemoveDependentModules(cachePath, sameInterface ? NULL : &dependents);
+
+	BinaryCache::RemoveBytecode(cachePath);
+	BinaryCache::PutBytecode(cachePath, bytecode, NULL, 0);
+
+	static char errorBuf[1024];
+	char *errorPos = errorBuf;
+	for(unsigned int i = 0; i < dependents.size(); i++)
+	{
+		if(nullcCompile(FindSource((ByteCode*)dependents[i].binary)))
+		{
+			char *dependentBytecode = NULL;
+			nullcGetBytecode(&dependentBytecode);
+			BinaryCache::PutBytecode(dependents[i].name, dependentBytecode, NULL, 0);
+		}else if(errorPos < errorBuf + 1023){
+			const char *format = errorPos == errorBuf ? "ERROR: modules that import '%s' couldn't be rebuilt and were removed: %s" : ", %s";
+			if(errorPos == errorBuf)
+				errorPos += SafeSprintf(errorPos, 1024, format, path, dependents[i].name);
+			else
+				errorPos += SafeSprintf(errorPos, 1024 - int(errorPos - errorBuf), format, dependents[i].name);
+		}
+
+		NULLC::dealloc((void*)dependents[i].name);
+		delete[] dependents[i].binary;
+	}
+
+	if(errorPos != errorBuf)
+	{
+		nullcLastError = errorBuf;
+		return false;
+	}
+	return true;
+}
+
 nullres nullcLoadModuleByBinary(const char* module, const char* binary)
 {
 	using namespace NULLC;
@@ -234,7 +313,7 @@ nullres nullcLoadModuleByBinary(const char* module, const char* binary)
 		return false;
 	}
 	// Duplicate binary
-	char *copy = (char*)NULLC::alloc(((ByteCode*)binary)->size);
+	char *copy = new char[((ByteCode*)binary)->size];
 	memcpy(copy, binary, ((ByteCode*)binary)->size);
 	binary = copy;
 	// Load it into cache
@@ -264,12 +343,62 @@ nullres	nullcCompile(const char* code)
 	NULLC_CHECK_INITIALIZED(false);
 
 	nullcLastError = "";
+
+	CodeInfo::ResetCompileStatistics();
 	nullres good = compiler->Compile(code);
+	CodeInfo::SetCompilePhase(NULLC_PHASE_COUNT);
+
 	if(good == 0)
 		nullcLastError = compiler->GetError();
 	return good;
 }
 
+nullres nullcSetInlineLimit(unsigned int nodeCount)
+{
+	using namespace NULLC;
+	NULLC_CHECK_INITIALIZED(false);
+
+	compiler->SetInlineLimit(nodeCount);
+	return true;
+}
+
+nullres nullcSetEvaluationLimits(unsigned int memorySize, unsigned int stepCount)
+{
+	using namespace NULLC;
+	NULLC_CHECK_INITIALIZED(false);
+
+	compiler->SetEvaluationLimits(memorySize, stepCount);
+	return true;
+}
+
+nullres nullcGetEvaluationStatistics(unsigned int *evaluatedCalls, unsigned int *failedCalls, unsigned int *stepCount)
+{
+	using namespace NULLC;
+	NULLC_CHECK_INITIALIZED(false);
+
+	compiler->GetEvaluationStatistics(evaluatedCalls, failedCalls, stepCount);
+	return true;
+}
+
+nullres nullcGetOverloadCacheStatistics(unsigned int *hits, unsigned int *misses)
+{
+	using namespace NULLC;
+	NULLC_CHECK_INITIALIZED(false);
+
+	compiler->GetOverloadCacheStatistics(hits, misses);
+	return true;
+}
+
+nullres nullcGetCompileStatistics(NULLCCompileStatistics *statistics)
+{
+	using namespace NULLC;
+	NULLC_CHECK_INITIALIZED(false);
+
+	*statistics = CodeInfo::compileStatistics;
+	statistics->syntaxTreeNodes = NodeZeroOP::createdNodes;
+	return true;
+}
+
 unsigned int nullcGetBytecode(char **bytecode)
 {
 	using namespace NULLC;
@@ -331,7 +460,11 @@ nullres nullcLinkCode(const char *bytecode)
 	NULLC_CHECK_INITIALIZED(false);
 
 #ifndef NULLC_NO_EXECUTOR
-	if(!linker->LinkCode(bytecode))
+	unsigned int lastPhase = CodeInfo::SetCompilePhase(NULLC_PHASE_LINKING);
+	bool linked = linker->LinkCode(bytecode);
+	CodeInfo::SetCompilePhase(lastPhase);
+
+	if(!linked)
 	{
 		nullcLastError = linker->GetLinkError();
 		return false;
@@ -785,6 +918,11 @@ nullres nullcSetFunction(const char* name, NULLCFuncPtr func)
 		nullcLastError = "ERROR: source function uses context, which is unavailable";
 		return false;
 	}
+	if(linker->exFunctions[index].isInlined)
+	{
+		nullcLastError = "ERROR: function calls were inlined, so it cannot be overridden";
+		return false;
+	}
 	if(nullcGetCurrentExecutor(NULL) == NULLC_X86)
 	{
 		linker->UpdateFunctionPointer(index, func.id);
@@ -992,6 +1130,10 @@ void nullcTerminate()
 
 	CodeInfo::namespaceInfo.reset();
 
+	NULLC::alloc = NULLC::untrackedAlloc;
+	NULLC::dealloc = NULLC::untrackedDealloc;
+	NULLC::ResetTrackedMemory();
+
 	initialized = false;
 }
 
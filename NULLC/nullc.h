@@ -39,6 +39,11 @@ nullres		nullcBindModuleFunction(const char* module, void (NCDECL *ptr)(), const
 /*	Builds module and saves its binary into binary cache	*/
 nullres		nullcLoadModuleBySource(const char* module, const char* code);
 
+/*	Replaces source of a module in binary cache, module is loaded if it isn't in the cache. Module isn't rebuilt if its source is unchanged.
+	If types, variables and function signatures of the module remain the same, modules that import it are kept and will be linked to the new code.
+	Otherwise, they are rebuilt from their source. Modules that fail to rebuild are removed from binary cache and the function fails with an error that lists them	*/
+nullres		nullcUpdateModuleBySource(const char* module, const char* code);
+
 /*	Loads module into binary cache	*/
 nullres		nullcLoadModuleByBinary(const char* module, const char* binary);
 
@@ -140,6 +145,27 @@ int			nullcInitDynamicModule();
 /*	Compiles the code and returns 1 on success	*/
 nullres			nullcCompile(const char* code);
 
+/*	Calls to functions that return an expression of up to 'nodeCount' nodes over their arguments are replaced with that expression
+	0 disables inlining, ~0u inlines every function that has a suitable body. Setting affects functions that are compiled after the call	*/
+nullres			nullcSetInlineLimit(unsigned int nodeCount);
+
+/*	Calls to pure functions with known arguments are evaluated at compile time using up to 'memorySize' bytes of stack
+	and up to 'stepCount' function calls and loop iterations. 0 in any limit disables the evaluation	*/
+nullres			nullcSetEvaluationLimits(unsigned int memorySize, unsigned int stepCount);
+
+/*	Get the number of pure function calls that were replaced with their result during the last compilation,
+	the number of calls that couldn't be evaluated and the total number of function calls and loop iterations performed	*/
+nullres			nullcGetEvaluationStatistics(unsigned int *evaluatedCalls, unsigned int *failedCalls, unsigned int *stepCount);
+
+/*	Get the number of function overload selections during the last compilation that were taken from the cache
+	and the number of selections that were performed and added to the cache	*/
+nullres			nullcGetOverloadCacheStatistics(unsigned int *hits, unsigned int *misses);
+
+/*	Get wall time, allocation count and peak memory of each compilation phase, along with the number of generic instances,
+	overload resolutions and syntax tree nodes. Statistics are reset by nullcCompile and include following nullcGetBytecode and nullcLinkCode calls.
+	Modules that are built from source during import are accounted in the phases of their own compilation	*/
+nullres			nullcGetCompileStatistics(NULLCCompileStatistics *statistics);
+
 /*	compiled bytecode to be used for linking and executing can be retrieved with this function
 	function returns bytecode size, and memory to which 'bytecode' points can be freed at any time	*/
 unsigned int	nullcGetBytecode(char **bytecode);
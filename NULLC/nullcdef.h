@@ -45,11 +45,20 @@ struct NULLCAutoArray
 #define NULLC_ERROR_BUFFER_SIZE 64 * 1024
 #define NULLC_MAX_GENERIC_INSTANCE_DEPTH 64
 #define NULLC_MAX_TYPE_SIZE	256 * 1024 * 1024
+#define NULLC_DEFAULT_INLINE_LIMIT 16
+#define NULLC_DEFAULT_EVALUATION_MEMORY 64 * 1024
+#define NULLC_DEFAULT_EVALUATION_STEPS 1024
 
 //#define NULLC_VM_PROFILE_INSTRUCTIONS
 //#define NULLC_STACK_TRACE_WITH_LOCALS
 //#define NULLC_VM_CALL_STACK_UNWRAP
 
+// VM instruction dispatch through a table of label addresses (GNU C computed goto) instead of a switch statement
+// Define NULLC_VM_SWITCH_DISPATCH to force the portable switch-based interpreter loop
+#if defined(__GNUC__) && !defined(NULLC_VM_SWITCH_DISPATCH)
+	#define NULLC_VM_COMPUTED_GOTO
+#endif
+
 //#define NULLC_LOG_FILES
 #if defined(_MSC_VER) && defined(_DEBUG)
 //#define VERBOSE_DEBUG_OUTPUT
@@ -58,6 +67,17 @@ struct NULLCAutoArray
 #endif
 //#define NULLC_ENABLE_C_TRANSLATION
 #define NULLC_PURE_FUNCTIONS
+// Calls to small functions that only return an expression over their arguments are replaced with that expression
+// Functions with inlined calls can't be overridden at run time and inlined calls are not present in the call stack of runtime errors
+#define NULLC_INLINE_FUNCTIONS
+// Invariant parts of loop conditions are computed once before the loop
+#define NULLC_LOOP_INVARIANT_MOTION
+// Repeated subexpressions of an expression without side effects are computed once
+#define NULLC_COMMON_SUBEXPRESSION_ELIMINATION
+// Unreachable statements, stores to unused local variables and unused values without side effects are removed from functions
+#define NULLC_DEAD_CODE_ELIMINATION
+// Objects allocated with 'new' that never leave the function through their pointer are placed on the stack
+#define NULLC_ESCAPE_ANALYSIS
 
 #if !defined(__CELLOS_LV2__) && !defined(__DMC__) && !defined(ANDROID)
 	#define NULLC_AUTOBINDING
@@ -94,6 +114,35 @@ typedef unsigned char nullres;
 #define NULLC_X86	1
 #define NULLC_LLVM	2
 
+// Compilation phases, see nullcGetCompileStatistics
+#define NULLC_PHASE_LEXING		0	// Source code lexing
+#define NULLC_PHASE_IMPORTS		1	// Module search and import of module types, functions and variables
+#define NULLC_PHASE_PARSING		2	// Parsing and semantic analysis
+#define NULLC_PHASE_GENERICS	3	// Instancing of generic functions and types
+#define NULLC_PHASE_CODEGEN		4	// Generation of instructions from the syntax tree
+#define NULLC_PHASE_BYTECODE	5	// Creation of bytecode
+#define NULLC_PHASE_LINKING		6	// Linking of bytecode
+#define NULLC_PHASE_COUNT		7
+
+// Resources spent in a single compilation phase
+struct NULLCPhaseStatistics
+{
+	double			time;			// Wall time in milliseconds
+	unsigned int	allocations;	// Number of memory blocks requested from the allocator
+	unsigned int	peakMemory;		// Largest amount of memory held during the phase that was allocated after the start of the nullcCompile, nullcGetBytecode or nullcLinkCode call, in bytes
+									// Memory that is kept by the compiler between calls and reused is not counted, so a small program compiled after a larger one might report 0
+};
+
+struct NULLCCompileStatistics
+{
+	NULLCPhaseStatistics	phases[NULLC_PHASE_COUNT];
+
+	unsigned int	genericFunctionInstances;
+	unsigned int	genericTypeInstances;
+	unsigned int	overloadResolutions;	// Number of times the best function overload was selected from the candidates
+	unsigned int	syntaxTreeNodes;
+};
+
 #ifdef __x86_64__
 	#define _M_X64
 #endif
@@ -1,5 +1,14 @@
 #include "stdafx.h"
 
+#if defined(_MSC_VER)
+	#define WIN32_LEAN_AND_MEAN
+	#include <windows.h>
+#elif defined(__linux) || defined(__APPLE__)
+	#include <sys/time.h>
+#else
+	#include <time.h>
+#endif
+
 void*	NULLC::defaultAlloc(int size)
 {
 	return ::new(std::nothrow) char[size];
@@ -12,6 +21,168 @@ void	NULLC::defaultDealloc(void* ptr)
 void*	(*NULLC::alloc)(int) = NULLC::defaultAlloc;
 void	(*NULLC::dealloc)(void*) = NULLC::defaultDealloc;
 
+void*	(*NULLC::untrackedAlloc)(int) = NULLC::defaultAlloc;
+void	(*NULLC::untrackedDealloc)(void*) = NULLC::defaultDealloc;
+
+unsigned int	NULLC::allocationCount = 0;
+size_t			NULLC::allocatedMemory = 0;
+size_t			NULLC::peakMemory = 0;
+
+namespace NULLC
+{
+	// Sizes of allocated blocks are kept in an open addressing table with linear probing, because the deallocation function doesn't receive the size
+	struct TrackedBlock
+	{
+		void			*ptr;
+		unsigned int	size;
+	};
+
+	TrackedBlock	*trackedBlocks = NULL;
+	unsigned int	trackedBlockCount = 0;
+	unsigned int	trackedBlockCapacity = 0;
+
+	unsigned int GetTrackedBlockSlot(void* ptr)
+	{
+		return (unsigned int)(((size_t)ptr >> 4) * 2654435761u) & (trackedBlockCapacity - 1);
+	}
+
+	void AddTrackedBlock(void* ptr, unsigned int size)
+	{
+		unsigned int slot = GetTrackedBlockSlot(ptr);
+		while(trackedBlocks[slot].ptr)
+			slot = (slot + 1) & (trackedBlockCapacity - 1);
+		trackedBlocks[slot].ptr = ptr;
+		trackedBlocks[slot].size = size;
+		trackedBlockCount++;
+	}
+
+	bool GrowTrackedBlocks()
+	{
+		TrackedBlock *oldBlocks = trackedBlocks;
+		unsigned int oldCapacity = trackedBlockCapacity;
+
+		unsigned int newCapacity = oldCapacity ? oldCapacity * 2 : 1024;
+		TrackedBlock *newBlocks = (TrackedBlock*)untrackedAlloc(newCapacity * sizeof(TrackedBlock));
+		if(!newBlocks)
+			return false;
+		memset(newBlocks, 0, newCapacity * sizeof(TrackedBlock));
+
+		trackedBlocks = newBlocks;
+		trackedBlockCapacity = newCapacity;
+		trackedBlockCount = 0;
+		for(unsigned int i = 0; i < oldCapacity; i++)
+		{
+			if(oldBlocks[i].ptr)
+				AddTrackedBlock(oldBlocks[i].ptr, oldBlocks[i].size);
+		}
+		if(oldBlocks)
+			untrackedDealloc(oldBlocks);
+		return true;
+	}
+
+	void RemoveTrackedBlock(void* ptr)
+	{
+		unsigned int slot = GetTrackedBlockSlot(ptr);
+		while(trackedBlocks[slot].ptr != ptr)
+		{
+			// Blocks that were allocated before the tracking has started are not in the table
+			if(!trackedBlocks[slot].ptr)
+				return;
+			slot = (slot + 1) & (trackedBlockCapacity - 1);
+		}
+		allocatedMemory -= trackedBlocks[slot].size;
+		trackedBlocks[slot].ptr = NULL;
+		trackedBlockCount--;
+
+		// Move the following blocks of the probe sequence into the free slot if it is between them and their home slot
+		unsigned int next = slot;
+		for(;;)
+		{
+			next = (next + 1) & (trackedBlockCapacity - 1);
+			if(!trackedBlocks[next].ptr)
+				break;
+			unsigned int home = GetTrackedBlockSlot(trackedBlocks[next].ptr);
+			if(slot <= next ? (slot < home && home <= next) : (slot < home || home <= next))
+				continue;
+			trackedBlocks[slot] = trackedBlocks[next];
+			trackedBlocks[next].ptr = NULL;
+			slot = next;
+		}
+	}
+}
+
+void* NULLC::trackedAlloc(int size)
+{
+	if(trackedBlockCount * 2 >= trackedBlockCapacity && !GrowTrackedBlocks())
+		return NULL;
+
+	void *ptr = untrackedAlloc(size);
+	if(!ptr)
+		return NULL;
+	AddTrackedBlock(ptr, size);
+
+	allocationCount++;
+	allocatedMemory += size;
+	if(allocatedMemory > peakMemory)
+		peakMemory = allocatedMemory;
+	return ptr;
+}
+
+void NULLC::trackedDealloc(void* ptr)
+{
+	if(ptr && trackedBlockCount)
+		RemoveTrackedBlock(ptr);
+	untrackedDealloc(ptr);
+}
+
+void NULLC::StartMemoryTracking()
+{
+	alloc = trackedAlloc;
+	dealloc = trackedDealloc;
+}
+
+void NULLC::StopMemoryTracking()
+{
+	alloc = untrackedAlloc;
+	dealloc = untrackedDealloc;
+
+	if(trackedBlocks)
+		memset(trackedBlocks, 0, trackedBlockCapacity * sizeof(TrackedBlock));
+	trackedBlockCount = 0;
+
+	allocatedMemory = 0;
+	peakMemory = 0;
+}
+
+void NULLC::ResetTrackedMemory()
+{
+	if(trackedBlocks)
+		untrackedDealloc(trackedBlocks);
+	trackedBlocks = NULL;
+	trackedBlockCount = 0;
+	trackedBlockCapacity = 0;
+
+	allocationCount = 0;
+	allocatedMemory = 0;
+	peakMemory = 0;
+}
+
+double NULLC::GetPreciseTime()
+{
+#if defined(_MSC_VER)
+	LARGE_INTEGER freq, count;
+	QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&count);
+	return double(count.QuadPart) / double(freq.QuadPart) * 1000.0;
+#elif defined(__linux) || defined(__APPLE__)
+	timeval time;
+	gettimeofday(&time, NULL);
+	return time.tv_sec * 1000.0 + time.tv_usec / 1000.0;
+#else
+	return clock() * 1000.0 / CLOCKS_PER_SEC;
+#endif
+}
+
 void* NULLC::alignedAlloc(int size)
 {
 	void *unaligned = alloc((size + 16 - 1) + sizeof(void*));
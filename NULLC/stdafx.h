@@ -41,6 +41,25 @@ namespace NULLC
 	extern void*	(*alloc)(int);
 	extern void		(*dealloc)(void*);
 
+	// Allocator that keeps track of the amount of memory held by NULLC, passes requests to 'untrackedAlloc' and 'untrackedDealloc'
+	void*	trackedAlloc(int size);
+	void	trackedDealloc(void* ptr);
+	void	ResetTrackedMemory();
+
+	// Route 'alloc' and 'dealloc' through the tracking allocator. Stopping the tracking forgets the blocks that are still held
+	void	StartMemoryTracking();
+	void	StopMemoryTracking();
+
+	extern void*	(*untrackedAlloc)(int);
+	extern void		(*untrackedDealloc)(void*);
+
+	extern unsigned int	allocationCount;
+	extern size_t		allocatedMemory;
+	extern size_t		peakMemory;
+
+	// Wall time in milliseconds
+	double	GetPreciseTime();
+
 	void*	alignedAlloc(int size);
 	void*	alignedAlloc(int size, int extraSize);
 	void	alignedDealloc(void* ptr);
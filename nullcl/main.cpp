@@ -6,13 +6,31 @@
 #include <string.h>
 #include <stdlib.h>
 
+void PrintCompileStatistics(const char *fileName)
+{
+	NULLCCompileStatistics stats;
+	nullcGetCompileStatistics(&stats);
+
+	const char *phaseNames[NULLC_PHASE_COUNT] = { "lexing", "imports", "parsing", "generics", "codegen", "bytecode", "linking" };
+
+	printf("Compilation statistics for %s:\n", fileName);
+	printf("%-10s %12s %12s %14s\n", "phase", "time (ms)", "allocations", "peak memory");
+	for(unsigned int i = 0; i < NULLC_PHASE_COUNT; i++)
+		printf("%-10s %12.3f %12u %14u\n", phaseNames[i], stats.phases[i].time, stats.phases[i].allocations, stats.phases[i].peakMemory);
+	printf("generic function instances: %u\n", stats.genericFunctionInstances);
+	printf("generic type instances: %u\n", stats.genericTypeInstances);
+	printf("overload resolutions: %u\n", stats.overloadResolutions);
+	printf("syntax tree nodes: %u\n", stats.syntaxTreeNodes);
+	printf("peak memory counts only the memory allocated during the compilation, memory that the compiler already held is not included\n");
+}
+
 int main(int argc, char** argv)
 {
 	nullcInit("Modules/");
 
 	if(argc == 1)
 	{
-		printf("usage: nullcl [-o output.ncm] file.nc [-m module.name] [file2.nc [-m module.name] ...]\n");
+		printf("usage: nullcl [--stats] [-o output.ncm] file.nc [-m module.name] [file2.nc [-m module.name] ...]\n");
 #ifdef NULLC_ENABLE_C_TRANSLATION
 		printf("usage: nullcl -c output.cpp file.nc\n");
 		printf("usage: nullcl -x output.exe file.nc\n");
@@ -20,8 +38,14 @@ int main(int argc, char** argv)
 		return 0;
 	}
 	int argIndex = 1;
+	bool printStatistics = false;
+	if(strcmp("--stats", argv[argIndex]) == 0)
+	{
+		printStatistics = true;
+		argIndex++;
+	}
 	FILE *mergeFile = NULL;
-	if(strcmp("-o", argv[argIndex]) == 0)
+	if(argIndex < argc && strcmp("-o", argv[argIndex]) == 0)
 	{
 		argIndex++;
 		if(argIndex == argc)
@@ -38,7 +62,7 @@ int main(int argc, char** argv)
 			return 0;
 		}
 		argIndex++;
-	}else if(strcmp("-c", argv[argIndex]) == 0 || strcmp("-x", argv[argIndex]) == 0){
+	}else if(argIndex < argc && (strcmp("-c", argv[argIndex]) == 0 || strcmp("-x", argv[argIndex]) == 0)){
 #ifdef NULLC_ENABLE_C_TRANSLATION
 		bool link = strcmp("-x", argv[argIndex]) == 0;
 		argIndex++;
@@ -196,6 +220,9 @@ int main(int argc, char** argv)
 		nullcGetBytecode((char**)&bytecode);
 		delete[] fileContent;
 
+		if(printStatistics)
+			PrintCompileStatistics(fileName);
+
 		// Create module name
 		char	moduleName[1024];
 		if(argIndex < argc && strcmp("-m", argv[argIndex]) == 0)
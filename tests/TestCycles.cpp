@@ -168,3 +168,132 @@ do\r\n\
 }while(0);\r\n\
 return 1;";
 TEST_RESULT("do...while cycle variable scope test 2", testDoWhileScope2, "1")
+
+const char	*testFusedInstructionCycles =
+"int sum(int[] arr){ int s = 0; for(int i = 0; i < arr.size; i++) s += arr[i]; return s; }\r\n\
+int[] a = { 1, 2, 3, 4, 5 };\r\n\
+int r = 0;\r\n\
+for(int i = 10; i > 0; i--)\r\n\
+	r += i - 1;\r\n\
+for(int i = 0; i <= 4; i++)\r\n\
+	r += a[i];\r\n\
+for(int i = 4; i >= 0; i--)\r\n\
+{\r\n\
+	if(i == 2)\r\n\
+		r += 100;\r\n\
+	else if(i != 3)\r\n\
+		r += 1000;\r\n\
+}\r\n\
+int x = 0;\r\n\
+while(x)\r\n\
+	r = -1;\r\n\
+int y = 5, z = 7;\r\n\
+r += y + z + 1;\r\n\
+return r + sum(a);";
+TEST_RESULT("Cycles with fused instruction sequences", testFusedInstructionCycles, "3188")
+
+const char	*testFrameSlotInstructions =
+"int calc(int a, int b)\r\n\
+{\r\n\
+	int r = 0;\r\n\
+	for(int i = 0; i < a; i++)\r\n\
+	{\r\n\
+		int x = i * b;\r\n\
+		int y = x - i;\r\n\
+		if(y >= 10)\r\n\
+			r += y;\r\n\
+		if(i <= 2)\r\n\
+			r -= 1;\r\n\
+		if(x == b)\r\n\
+			r += 1000;\r\n\
+		if(i != a - 1)\r\n\
+			r = r * 1;\r\n\
+		if(a > i)\r\n\
+			r = r + 2;\r\n\
+	}\r\n\
+	int k = 7;\r\n\
+	int m = k++;\r\n\
+	int n = --k;\r\n\
+	return r + m * 100 + n * 10000;\r\n\
+}\r\n\
+int g = 3, h = 4;\r\n\
+int s = g * h;\r\n\
+s = s + 5;\r\n\
+int c = 0;\r\n\
+while(c < s)\r\n\
+	c++;\r\n\
+int d = c--;\r\n\
+return calc(10, 4) + c + d;";
+TEST_RESULT("Cycles with three-address frame slot instructions", testFrameSlotInstructions, "71867")
+
+const char	*testLoopInvariantMotion =
+"class M{ int[] data; int w; }\r\n\
+int sum(M ref m)\r\n\
+{\r\n\
+	int s = 0;\r\n\
+	for(int y = 0; y < m.data.size / m.w; y++)\r\n\
+		s += m.data[y];\r\n\
+	return s;\r\n\
+}\r\n\
+int shrink(M ref m)\r\n\
+{\r\n\
+	int i = 0;\r\n\
+	while(i < m.w * 2)\r\n\
+	{\r\n\
+		m.w--;\r\n\
+		i++;\r\n\
+	}\r\n\
+	return i;\r\n\
+}\r\n\
+int[] g = { 1, 2, 3 };\r\n\
+void grow(){ g = new int[g.size + 1]; }\r\n\
+int grown()\r\n\
+{\r\n\
+	int i = 0;\r\n\
+	while(i < g.size - 1 && i < 20)\r\n\
+	{\r\n\
+		grow();\r\n\
+		i++;\r\n\
+	}\r\n\
+	return i;\r\n\
+}\r\n\
+int escaped(int n)\r\n\
+{\r\n\
+	int i = 0;\r\n\
+	int ref p = &n;\r\n\
+	for(; i < n * 2; i++)\r\n\
+		*p = *p - 1;\r\n\
+	return i;\r\n\
+}\r\n\
+int direct(int n)\r\n\
+{\r\n\
+	int i = 0;\r\n\
+	while(i < n - 2)\r\n\
+	{\r\n\
+		n--;\r\n\
+		i++;\r\n\
+	}\r\n\
+	return i;\r\n\
+}\r\n\
+int closure(int n)\r\n\
+{\r\n\
+	int i = 0;\r\n\
+	void dec(){ n--; }\r\n\
+	for(; i < n - 2; i++)\r\n\
+		dec();\r\n\
+	return i;\r\n\
+}\r\n\
+int nested(int[] arr, int k)\r\n\
+{\r\n\
+	int s = 0;\r\n\
+	for(int i = 0; i < arr.size - k; i++)\r\n\
+		for(int j = i; j < arr.size * k && j < i + 2; j++)\r\n\
+			s += arr[j];\r\n\
+	return s;\r\n\
+}\r\n\
+M m;\r\n\
+m.data = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };\r\n\
+m.w = 2;\r\n\
+int a = 5, b = 10, c = 8;\r\n\
+return sum(m) + shrink(m) * 100 + grown() * 1000 + escaped(a) * 100000 + direct(b) * 1000000 + closure(b) * 10000000 + nested(m.data, c) * 100000000;";
+TEST_RESULT("Loop-invariant parts of loop conditions are computed once", testLoopInvariantMotion, "844420215")
@@ -188,3 +188,15 @@ const char	*testInOperatorOnArray =
 "int[] arr = { 1, 2, 3, 4 };\r\n\
 return (3 in arr) && !(6 in arr);";
 TEST_RESULT("in operator on array", testInOperatorOnArray, "1");
+
+const char	*testForEachArrayReplaced =
+"int[] arr = { 1, 2, 3, 4 };\r\n\
+int sum = 0;\r\n\
+for(i in arr)\r\n\
+{\r\n\
+	sum += i;\r\n\
+	if(i == 2)\r\n\
+		arr = { 10, 20, 30 };\r\n\
+}\r\n\
+return sum;";
+TEST_RESULT("For each over array that is replaced in the loop body", testForEachArrayReplaced, "33");
@@ -258,6 +258,47 @@ const char	*testCompileTimeFunctionEvaluationBug9 =
 return foo(0, 1 << 16);";
 TEST_RESULT("Compile-time function evaluation bug 9 (compilation hang)", testCompileTimeFunctionEvaluationBug9, "131072");
 
+const char	*testCompileTimeFunctionEvaluationLoops =
+"int table(int n)\r\n\
+{\r\n\
+	int[32] squares;\r\n\
+	for(int i = 0; i < 32; i++)\r\n\
+		squares[i] = i * i;\r\n\
+	return squares[n];\r\n\
+}\r\n\
+int primes(int limit)\r\n\
+{\r\n\
+	int count = 0;\r\n\
+	for(int i = 2; i < limit; i++)\r\n\
+	{\r\n\
+		int k = 2;\r\n\
+		while(k * k <= i)\r\n\
+		{\r\n\
+			if(i % k == 0)\r\n\
+				break;\r\n\
+			k++;\r\n\
+		}\r\n\
+		if(k * k <= i)\r\n\
+			continue;\r\n\
+		count++;\r\n\
+	}\r\n\
+	return count;\r\n\
+}\r\n\
+int digits(int x)\r\n\
+{\r\n\
+	int n = 0;\r\n\
+	do\r\n\
+	{\r\n\
+		n++;\r\n\
+		x /= 10;\r\n\
+	}while(x);\r\n\
+	return n;\r\n\
+}\r\n\
+int fib(int n){ return n < 2 ? n : fib(n - 1) + fib(n - 2); }\r\n\
+int find(int n){ for(int i = 0; i < 100; i++){ for(int j = 0; j < 100; j++){ if(i * j == n) return i * 100 + j; } } return -1; }\r\n\
+return table(31) + primes(200) * 10000 + digits(12345) * 1000000 + fib(30) + find(77);";
+TEST_RESULT("Compile-time function evaluation of while, do-while, break, continue and nested loops", testCompileTimeFunctionEvaluationLoops, "6293178");
+
 const char	*testExplicitArguments1 =
 "int foo(explicit int a, b){ return a + b; }\r\n\
 return foo(3, 4);";
@@ -276,3 +317,39 @@ float bar(){ return 2.0; }\r\n\
 \r\n\
 return foo(bar);";
 TEST_RESULT("Explicit function arguments 3", testExplicitArguments3, "8");
+
+const char	*testFunctionInlining1 =
+"class P{ int x, y; int sum(){ return x + y; } }\r\n\
+int add(int a, int b){ return a + b; }\r\n\
+double half(float x){ return x / 2; }\r\n\
+char low(char c, short s){ return c + s; }\r\n\
+long wide(long a, int b){ return a * b; }\r\n\
+P p; p.x = 3; p.y = 4;\r\n\
+int q = 2;\r\n\
+int foo(int z){ P t; t.x = z; t.y = 1; return add(z, q) + t.sum() + low(1, 2); }\r\n\
+return add(q, 3) + p.sum() + foo(5) + int(half(q) * 4) + int(wide(1l << 40, q) >> 40);";
+TEST_RESULT("Function inlining 1", testFunctionInlining1, "34");
+
+const char	*testFunctionInlining2 =
+"class A{ int v; }\r\n\
+int deep(int n){ return n ? deep(n - 1) + 1 : 0; }\r\n\
+int get(A ref a, int n){ return deep(n) + a.v; }\r\n\
+int test(){ A a; a.v = 5; int k = 5000; return get(a, k); }\r\n\
+int sq(int x){ return x * x; }\r\n\
+int sumsq(int a, b){ return sq(a) + sq(b); }\r\n\
+int fib(int n){ return n < 2 ? n : fib(n - 1) + fib(n - 2); }\r\n\
+int twice(int a = sq(3)){ return a * 2; }\r\n\
+int n = 10;\r\n\
+return test() + sumsq(n, 2) + fib(n) + twice() + sumsq(sumsq(1, 1), 1);";
+TEST_RESULT("Function inlining 2 (nested calls and stack reallocation)", testFunctionInlining2, "5187");
+
+const char	*testFunctionInlining3 =
+"import std.vector;\r\n\
+int add(int a, int b){ return a + b; }\r\n\
+coroutine int gen(){ int i = 0; while(1){ yield add(i, 1); i++; } }\r\n\
+vector<int> v; v.push_back(4); v.push_back(5);\r\n\
+int s = 0;\r\n\
+for(int i = 0; i < v.size(); i++)\r\n\
+	s = add(s, v[i]);\r\n\
+return s * 10 + gen() + gen() + gen();";
+TEST_RESULT("Function inlining 3 (generic type members and coroutines)", testFunctionInlining3, "96");
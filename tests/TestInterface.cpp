@@ -2,6 +2,7 @@
 
 #include "TestBase.h"
 #include "../NULLC/nullc_debug.h"
+#include "../NULLC/Lexer.h"
 
 bool	initialized;
 
@@ -23,6 +24,81 @@ bool	initialized;
 		testsPassed[TEST_EXTRA_INDEX]++;\
 	}
 
+bool IsModuleLoaded(const char* name)
+{
+	for(unsigned int i = 0; nullcEnumerateModules(i); i++)
+	{
+		if(strcmp(nullcEnumerateModules(i), name) == 0)
+			return true;
+	}
+	return false;
+}
+
+// Count instructions in the code of a function from the last build, fused instructions are counted by the instruction they start with
+unsigned int CountInstructions(const char* function, InstructionCode cmd, unsigned int flag)
+{
+	unsigned int functionCount = 0, codeSize = 0;
+	ExternFuncInfo *functions = nullcDebugFunctionInfo(&functionCount);
+	char *symbols = nullcDebugSymbols(NULL);
+	VMCmd *code = nullcDebugCode(&codeSize);
+
+	unsigned int count = 0;
+	for(unsigned int i = 0; i < functionCount; i++)
+	{
+		if(functions[i].address == -1 || strcmp(symbols + functions[i].offsetToName, function) != 0)
+			continue;
+		for(unsigned int k = functions[i].address; k < (unsigned int)functions[i].address + functions[i].codeSize && k < codeSize; k++)
+		{
+			if(cmdBaseInstruction(code[k].cmd) == cmd && (code[k].flag & flag) == flag)
+				count++;
+		}
+	}
+	return count;
+}
+
+// Count calls to a function with the specified name in the code of a function from the last build
+unsigned int CountCalls(const char* function, const char* callee)
+{
+	unsigned int functionCount = 0, codeSize = 0;
+	ExternFuncInfo *functions = nullcDebugFunctionInfo(&functionCount);
+	char *symbols = nullcDebugSymbols(NULL);
+	VMCmd *code = nullcDebugCode(&codeSize);
+
+	unsigned int count = 0;
+	for(unsigned int i = 0; i < functionCount; i++)
+	{
+		if(functions[i].address == -1 || strcmp(symbols + functions[i].offsetToName, function) != 0)
+			continue;
+		for(unsigned int k = functions[i].address; k < (unsigned int)functions[i].address + functions[i].codeSize && k < codeSize; k++)
+		{
+			if(cmdBaseInstruction(code[k].cmd) == cmdCall && code[k].argument < functionCount && strcmp(symbols + functions[code[k].argument].offsetToName, callee) == 0)
+				count++;
+		}
+	}
+	return count;
+}
+
+// Check if a function from the last build has a local variable with a name that starts with the prefix
+bool HasLocal(const char* function, const char* prefix)
+{
+	unsigned int functionCount = 0, localCount = 0;
+	ExternFuncInfo *functions = nullcDebugFunctionInfo(&functionCount);
+	ExternLocalInfo *locals = nullcDebugLocalInfo(&localCount);
+	char *symbols = nullcDebugSymbols(NULL);
+
+	for(unsigned int i = 0; i < functionCount; i++)
+	{
+		if(strcmp(symbols + functions[i].offsetToName, function) != 0)
+			continue;
+		for(unsigned int k = functions[i].offsetToFirstLocal; k < functions[i].offsetToFirstLocal + functions[i].localCount && k < localCount; k++)
+		{
+			if(strncmp(symbols + locals[k].offsetToName, prefix, strlen(prefix)) == 0)
+				return true;
+		}
+	}
+	return false;
+}
+
 void RunInterfaceTests()
 {
 	unsigned int	testTarget[] = { NULLC_VM, NULLC_X86, NULLC_LLVM };
@@ -575,6 +651,212 @@ void RunInterfaceTests()
 	TEST_COMPARE(nullcRunFunction("foo"), 1);
 	TEST_COMPARE(nullcGetResultInt(), 6);
 
+#ifdef NULLC_INLINE_FUNCTIONS
+	// Inlined function doesn't have its own stack frame
+	nullcBuild("int foo(int[] a, int i){ return a[i]; } int[2] arr; int i = 3; return foo(arr, i);");
+	TEST_COMPARE(nullcRun(), 0);
+	TEST_COMPARE(strstr(nullcGetLastError(), "foo (line") == NULL, true);
+	TEST_COMPARE(nullcSetInlineLimit(0), 1);
+	nullcBuild("int foo(int[] a, int i){ return a[i]; } int[2] arr; int i = 3; return foo(arr, i);");
+	TEST_COMPARE(nullcRun(), 0);
+	TEST_COMPARE(strstr(nullcGetLastError(), "foo (line") != NULL, true);
+	TEST_COMPARE(nullcSetInlineLimit(NULLC_DEFAULT_INLINE_LIMIT), 1);
+
+	// Function with inlined calls can't be overridden at run time
+	TEST_COMPARE(nullcLoadModuleBySource("test.modC", "int g = 1; int foo(int x){ return x + g; } int bar(int x){ return foo(x) + 10; }"), 1);
+	TEST_COMPARE(nullcBuild("import test.modC; import std.dynamic; int foo2(int x){ return x * 100; } override(foo, foo2); return bar(3);"), 1);
+	TEST_COMPARE(nullcRun(), 0);
+	TEST_COMPARE(strstr(nullcGetLastError(), "Function 'foo' cannot be overridden") != NULL, true);
+	TEST_COMPARE(nullcBuild("int foo(int x){ return x + 1; } int foo2(int x){ return x * 100; } int a = 3; return foo(a);"), 1);
+	{
+		NULLCFuncPtr fooNew;
+		TEST_COMPARE(nullcGetFunction("foo2", &fooNew), 1);
+		TEST_COMPARE(nullcSetFunction("foo", fooNew), 0);
+		TEST_COMPARES(nullcGetLastError(), "ERROR: function calls were inlined, so it cannot be overridden");
+	}
+	TEST_COMPARE(nullcSetInlineLimit(0), 1);
+#endif
+
+	// Function called from another module can be overridden at run time
+	TEST_COMPARE(nullcLoadModuleBySource("test.modD", "int g = 1; int foo(int x){ return x + g; } int bar(int x){ return foo(x) + 10; }"), 1);
+	TEST_COMPARE(nullcBuild("import test.modD; import std.dynamic; int foo2(int x){ return x * 100; } override(foo, foo2); return bar(3);"), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 310);
+	nullcBuild("int foo(int[] a, int i){ return a[i]; } int[2] arr; int i = 3; return foo(arr, i);");
+	TEST_COMPARE(nullcRun(), 0);
+	TEST_COMPARE(strstr(nullcGetLastError(), "foo (line") != NULL, true);
+	TEST_COMPARE(nullcSetInlineLimit(NULLC_DEFAULT_INLINE_LIMIT), 1);
+
+	// Calls to pure functions are reused without inlining
+	TEST_COMPARE(nullcSetInlineLimit(0), 1);
+	TEST_COMPARE(nullcBuild("int sq(int x){ int y = x * x; return y; } int twice(int x){ return sq(x) + sq(x); } return twice(3);"), 1);
+	TEST_COMPARE(CountInstructions("twice", cmdCall, 0), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 18);
+	TEST_COMPARE(nullcSetInlineLimit(NULLC_DEFAULT_INLINE_LIMIT), 1);
+
+	// Bounds checks are removed from counted loops that don't change the counter or the array
+	TEST_COMPARE(nullcBuild("int sumAll(int[] arr){ int s = 0; for(int i = 0; i < arr.size; i++) s += arr[i]; return s; }\r\n\
+int sumEach(int[] arr){ int s = 0; for(i in arr) s += i; return s; }\r\n\
+int sumChanged(int[] arr){ int s = 0; for(int i = 0; i < arr.size; i++){ s += arr[i]; arr = new int[1]; } return s; }\r\n\
+int sumSkip(int[] arr){ int s = 0; for(int i = 0; i < arr.size; i++){ s += arr[i]; i++; } return s; }\r\n\
+return sumAll({ 1, 2, 3 }) + sumEach({ 4, 5 }) + sumChanged({ 6 }) + sumSkip({ 7, 8 });"), 1);
+	TEST_COMPARE(CountInstructions("sumAll", cmdIndexStk, INDEX_UNCHECKED), 1);
+	TEST_COMPARE(CountInstructions("sumEach", cmdIndexStk, INDEX_UNCHECKED), 1);
+	TEST_COMPARE(CountInstructions("sumChanged", cmdIndexStk, INDEX_UNCHECKED), 0);
+	TEST_COMPARE(CountInstructions("sumChanged", cmdIndexStk, 0), 1);
+	TEST_COMPARE(CountInstructions("sumSkip", cmdIndexStk, INDEX_UNCHECKED), 0);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 28);
+
+	// Invariant parts of loop conditions are computed into a hidden variable before the loop
+	TEST_COMPARE(nullcBuild("int sumRows(int[] data, int w){ int s = 0; for(int y = 0; y < data.size / w; y++) s += data[y]; return s; }\r\n\
+int countRows(int[] data, int w){ int i = 0; while(i < data.size / w){ w++; i++; } return i; }\r\n\
+return sumRows({ 1, 2, 3, 4 }, 2) * 10 + countRows({ 1, 2, 3, 4 }, 1);"), 1);
+	TEST_COMPARE(HasLocal("sumRows", "$tempopt"), true);
+	TEST_COMPARE(HasLocal("countRows", "$tempopt"), false);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 32);
+
+	// Repeated subexpressions are computed once when there are no side effects between them
+	TEST_COMPARE(nullcBuild("class Node{ Node ref next; int value; }\r\n\
+int twice(Node ref n){ return n.next.value * 3 + n.next.value * 3; }\r\n\
+int store(Node ref n, int ref p){ return n.next.value * 3 + (*p = 10) + n.next.value * 3; }\r\n\
+Node a, b; a.next = &b; b.value = 5;\r\n\
+return twice(a) * 100 + store(a, &b.value);"), 1);
+	TEST_COMPARE(CountInstructions("twice", cmdMul, 0), 1);
+	TEST_COMPARE(CountInstructions("store", cmdMul, 0), 2);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 3055);
+
+	// Unused calls are removed only for pure functions that can't fail
+	TEST_COMPARE(nullcBuild("int sq(int x){ int y = x * x; return y + 1; } int div(int a, int b){ int r = a / b; return r; }\r\n\
+int unusedSq(int x){ sq(x); return x; }\r\n\
+int unusedDiv(int x){ div(x, 1); return x; }\r\n\
+return unusedSq(2) + unusedDiv(3);"), 1);
+	TEST_COMPARE(CountInstructions("unusedSq", cmdCall, 0), 0);
+	TEST_COMPARE(CountInstructions("unusedDiv", cmdCall, 0), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 5);
+
+	// Objects that don't leave the function are placed on the stack instead of the heap
+	TEST_COMPARE(nullcBuild("class vec3{ double x, y, z; } vec3 ref keep;\r\n\
+double len2(double a, double b){ vec3 ref v = new vec3; v.x = a; v.y = b; return v.x * v.x + v.y * v.y; }\r\n\
+double kept(double a){ vec3 ref v = new vec3; v.x = a; keep = v; return v.x; }\r\n\
+return int(len2(3, 4) + kept(2));"), 1);
+	TEST_COMPARE(CountCalls("len2", "__newS"), 0);
+	TEST_COMPARE(CountCalls("kept", "__newS"), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 27);
+
+	// Calls to pure functions with known arguments are replaced with their result unless they exceed the evaluation limits
+	{
+		const char *code = "int sq(int x){ int y = x * x; return y; } int sum(int n){ int s = 0; for(int i = 0; i < n; i++) s += i; return s; } int digits(int x){ int n = 0; do{ n++; x /= 10; }while(x); return n; } return sq(5) + sum(10) + sum(5000) / 1000000 + digits(12345) * 1000;";
+		unsigned int evaluatedCalls = 0, failedCalls = 0, stepCount = 0;
+
+		TEST_COMPARE(nullcBuild(code), 1);
+		TEST_COMPARE(nullcGetEvaluationStatistics(&evaluatedCalls, &failedCalls, &stepCount), 1);
+		TEST_COMPARE(evaluatedCalls, 3);
+		TEST_COMPARE(failedCalls, 1);
+		TEST_COMPARE(stepCount > NULLC_DEFAULT_EVALUATION_STEPS, true);
+		TEST_COMPARE(nullcRun(), 1);
+		TEST_COMPARE(nullcGetResultInt(), 5082);
+
+		TEST_COMPARE(nullcSetEvaluationLimits(0, NULLC_DEFAULT_EVALUATION_STEPS), 1);
+		TEST_COMPARE(nullcBuild(code), 1);
+		TEST_COMPARE(nullcGetEvaluationStatistics(&evaluatedCalls, &failedCalls, &stepCount), 1);
+		TEST_COMPARE(evaluatedCalls, 0);
+		TEST_COMPARE(stepCount, 0);
+		TEST_COMPARE(nullcRun(), 1);
+		TEST_COMPARE(nullcGetResultInt(), 5082);
+
+		TEST_COMPARE(nullcSetEvaluationLimits(NULLC_DEFAULT_EVALUATION_MEMORY, 0), 1);
+		TEST_COMPARE(nullcBuild(code), 1);
+		TEST_COMPARE(nullcGetEvaluationStatistics(&evaluatedCalls, &failedCalls, &stepCount), 1);
+		TEST_COMPARE(evaluatedCalls, 0);
+		TEST_COMPARE(nullcRun(), 1);
+		TEST_COMPARE(nullcGetResultInt(), 5082);
+
+		TEST_COMPARE(nullcSetEvaluationLimits(NULLC_DEFAULT_EVALUATION_MEMORY, NULLC_DEFAULT_EVALUATION_STEPS), 1);
+	}
+
+	// Every keyword has its own entry in the lexer keyword table, identifiers that share the hash of a keyword are not keywords
+	{
+		const char *keywords = "if in do for ref new case else auto true enum with while break class align yield const false switch return typeof sizeof import noalign default typedef nullptr generic continue operator coroutine namespace extendable rxf cxse whxle";
+		LexemeType types[] = { lex_if, lex_in, lex_do, lex_for, lex_ref, lex_new, lex_case, lex_else, lex_auto, lex_true, lex_enum, lex_with, lex_while, lex_break, lex_class, lex_align, lex_yield, lex_const, lex_false,
+			lex_switch, lex_return, lex_typeof, lex_sizeof, lex_import, lex_noalign, lex_default, lex_typedef, lex_nullptr, lex_generic, lex_continue, lex_operator, lex_coroutine, lex_namespace, lex_extendable, lex_string, lex_string, lex_string, lex_none };
+
+		Lexer lexer;
+		lexer.Lexify(keywords);
+		TEST_COMPARE(lexer.GetStreamSize(), sizeof(types) / sizeof(types[0]));
+		for(unsigned int i = 0; i < lexer.GetStreamSize() && i < sizeof(types) / sizeof(types[0]); i++)
+		{
+			TEST_COMPARE(lexer.GetStreamStart()[i].type, types[i]);
+		}
+	}
+
+	// Compilation statistics cover compilation, bytecode creation and linking
+	{
+		// Source is larger than the other programs built here, so that the compiler can't reuse the memory it already holds
+		const unsigned int functionCount = 512;
+		char *source = new char[functionCount * 64 + 256];
+		char *pos = source;
+		for(unsigned int i = 0; i < functionCount; i++)
+			pos += sprintf(pos, "int f%d(int x){ int y = x * %d; return y + 1; }\r\n", i, i);
+		strcpy(pos, "class Foo<T>{ T x; } int foo(generic a){ return 1; } int foo(int a, int b){ return 2; } Foo<int> a; Foo<double> b; return foo(1) + foo(2.0) + foo(3, 4);");
+		TEST_COMPARE(nullcBuild(source), 1);
+		delete[] source;
+
+		NULLCCompileStatistics stats;
+		TEST_COMPARE(nullcGetCompileStatistics(&stats), 1);
+		TEST_COMPARE(stats.genericFunctionInstances, 2);
+		TEST_COMPARE(stats.genericTypeInstances, 2);
+		TEST_COMPARE(stats.overloadResolutions != 0, true);
+		TEST_COMPARE(stats.syntaxTreeNodes > functionCount, true);
+		for(unsigned int i = 0; i < NULLC_PHASE_COUNT; i++)
+		{
+			TEST_COMPARE(stats.phases[i].allocations == 0 || stats.phases[i].peakMemory != 0, true);
+		}
+		TEST_COMPARE(stats.phases[NULLC_PHASE_LEXING].time > 0.0, true);
+		TEST_COMPARE(stats.phases[NULLC_PHASE_PARSING].time > 0.0, true);
+		TEST_COMPARE(stats.phases[NULLC_PHASE_PARSING].allocations != 0, true);
+		TEST_COMPARE(stats.phases[NULLC_PHASE_PARSING].peakMemory != 0, true);
+		TEST_COMPARE(stats.phases[NULLC_PHASE_CODEGEN].allocations != 0, true);
+	}
+
+	// Modules that import an updated module are relinked, or rebuilt from their source when its interface changes
+	TEST_COMPARE(nullcLoadModuleBySource("test.updateA", "int foo(int x){ return x * 2; }"), 1);
+	TEST_COMPARE(nullcLoadModuleBySource("test.updateB", "import test.updateA; int bar(int x){ return foo(x) + 1; }"), 1);
+	TEST_COMPARE(nullcBuild("import test.updateB; return bar(5);"), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 11);
+	TEST_COMPARE(nullcUpdateModuleBySource("test.updateA", "int foo(int x){ int y = x * 3; return y; }"), 1);
+	TEST_COMPARE(IsModuleLoaded("test/updateB.nc"), true);
+	TEST_COMPARE(nullcBuild("import test.updateB; return bar(5);"), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 16);
+	TEST_COMPARE(nullcUpdateModuleBySource("test.updateA", "int foo(int x){ int y = x * 3; return y; }"), 1);
+	TEST_COMPARE(nullcUpdateModuleBySource("test.updateA", "int foo(int x, int y = 4){ return x * y; }"), 1);
+	TEST_COMPARE(IsModuleLoaded("test/updateB.nc"), true);
+	TEST_COMPARE(nullcBuild("import test.updateB; return bar(5);"), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 21);
+	TEST_COMPARE(nullcLoadModuleBySource("test.updateC", "import test.updateA; int baz(int x){ return foo(x, 2); }"), 1);
+	TEST_COMPARE(nullcLoadModuleBySource("test.updateD", "import test.updateB; int qux(int x){ return bar(x) * 2; }"), 1);
+	TEST_COMPARE(nullcLoadModuleBySource("test.updateE", "import test.updateA; import test.updateD; int quux(int x){ return qux(foo(x)); }"), 1);
+	TEST_COMPARE(nullcUpdateModuleBySource("test.updateA", "int foo(int x){ return x * 5; }"), 0);
+	TEST_COMPARES(nullcGetLastError(), "ERROR: modules that import 'test/updateA.nc' couldn't be rebuilt and were removed: test/updateC.nc");
+	TEST_COMPARE(IsModuleLoaded("test/updateB.nc"), true);
+	TEST_COMPARE(IsModuleLoaded("test/updateC.nc"), false);
+	TEST_COMPARE(IsModuleLoaded("test/updateD.nc"), true);
+	TEST_COMPARE(IsModuleLoaded("test/updateE.nc"), true);
+	TEST_COMPARE(nullcBuild("import test.updateE; return quux(1);"), 1);
+	TEST_COMPARE(nullcRun(), 1);
+	TEST_COMPARE(nullcGetResultInt(), 52);
+	TEST_COMPARE(nullcUpdateModuleBySource("test.updateA", "int foo(int x, int y = 4){ return x * y; }"), 1);
+	TEST_COMPARE(nullcUpdateModuleBySource("test.updateA", "int foo(int x, int y = 4){ return x + ; }"), 0);
+	TEST_COMPARE(IsModuleLoaded("test/updateB.nc"), true);
+
 	nullcTerminate();
 	TEST_COMPARES(nullcGetLastError(), "");
 
@@ -632,6 +914,11 @@ void RunInterfaceTests()
 	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
 	TEST_COMPARE(nullcLinkCode(temp), false);
 	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
+	TEST_COMPARE(nullcSetInlineLimit(0), false);
+	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
+	NULLCCompileStatistics stats;
+	TEST_COMPARE(nullcGetCompileStatistics(&stats), false);
+	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
 
 #ifdef NULLC_BUILD_X86_JIT
 	TEST_COMPARE(nullcSetJiTStack(NULL, NULL, true), false);
@@ -641,6 +928,8 @@ void RunInterfaceTests()
 	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
 	TEST_COMPARE(nullcLoadModuleBySource("std.test", "return 1;"), false);
 	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
+	TEST_COMPARE(nullcUpdateModuleBySource("std.test", "return 1;"), false);
+	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
 	TEST_COMPARE(nullcLoadModuleByBinary("std.test", NULL), false);
 	TEST_COMPARES(nullcGetLastError(), "ERROR: NULLC is not initialized");
 
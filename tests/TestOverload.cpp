@@ -234,3 +234,31 @@ auto ref y = &x;\r\n\
 auto[] z = y;\r\n\
 return int(z[2]);";
 TEST_RESULT("overloaded operator in variable definition is called before implicit conversions", testOverloadedOperatorInDefinition, "3");
+
+const char	*testOverloadSelectionCache =
+"class Foo{ int x; }\r\n\
+int f(double x){ return 1; }\r\n\
+int a = f(1) + f(2);\r\n\
+int f(int x){ return 2; }\r\n\
+int b = f(1) + f(2);\r\n\
+int g(generic x){ return 3; }\r\n\
+Foo foo;\r\n\
+int c = g(foo) + g(foo);\r\n\
+int g(Foo ref x){ return 4; }\r\n\
+int d = g(&foo) + g(foo);\r\n\
+int h(){ int f(long x){ return 5; } return f(1) + f(2l); }\r\n\
+int e = h() + f(1);\r\n\
+return a + b * 10 + c * 100 + d * 1000 + e * 10000;";
+TEST("Cached overload selection is updated when new overloads are defined", testOverloadSelectionCache, "97642")
+{
+	// Counts include implicit operator and constructor lookups. A new overload of 'f' or 'g' changes the candidate list and an instance of
+	// generic 'g' invalidates selections with generic candidates, so the repeated calls after them are selected again
+	unsigned int hits = 0, misses = 0;
+	nullcGetOverloadCacheStatistics(&hits, &misses);
+	if(hits != 15 || misses != 15)
+	{
+		TEST_NAME();
+		printf(" Failed overload cache hits %u (expected 15), misses %u (expected 15)\r\n", hits, misses);
+		lastFailed = true;
+	}
+}
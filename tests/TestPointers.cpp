@@ -167,3 +167,114 @@ auto x = &p;\r\n\
 x[0].y++;\r\n\
 return p[0].y;";
 TEST_RESULT("Syntax tree optimization failure check 4", testASTOptimizationFail4, "1");
+
+const char *testCommonSubexpressions =
+"class Node{ Node ref next; int value; }\r\n\
+int square(int x){ return x * x + 1; }\r\n\
+int change(Node ref n){ n.next.value = 100; return 0; }\r\n\
+int twice(Node ref n)\r\n\
+{\r\n\
+	return n.next.value * 2 + n.next.value * 2;\r\n\
+}\r\n\
+int store(Node ref n, int ref p)\r\n\
+{\r\n\
+	return n.next.value * 2 + (*p = 10) + n.next.value * 2;\r\n\
+}\r\n\
+int call(Node ref n)\r\n\
+{\r\n\
+	return n.next.value * 2 + change(n) + n.next.value * 2;\r\n\
+}\r\n\
+int pure(int x)\r\n\
+{\r\n\
+	return square(x + 1) * 2 + square(x + 1) * 2;\r\n\
+}\r\n\
+int logic(Node ref n, int x)\r\n\
+{\r\n\
+	return (x > 0 && n.next.value * 3 > 1) + n.next.value * 3;\r\n\
+}\r\n\
+Node a, b, c, d;\r\n\
+a.next = &b;\r\n\
+b.value = 5;\r\n\
+c.next = &d;\r\n\
+d.value = 5;\r\n\
+int x = 2, y = 0;\r\n\
+int r1 = twice(a), r2 = logic(a, y), r3 = logic(a, x), r4 = pure(x), r5 = store(a, &b.value), r6 = call(c);\r\n\
+return r1 + r2 * 100 + r3 * 10000 + r4 * 1000000 + (r5 * 1000 + r6 == 40210 ? 1000000000 : 0);";
+TEST_RESULT("Repeated subexpressions are reused only without side effects between them", testCommonSubexpressions, "1040161520");
+
+const char *testDeadCode =
+"int counter = 0;\r\n\
+int tick(){ counter++; return counter; }\r\n\
+int unused(int x)\r\n\
+{\r\n\
+	int a = tick();\r\n\
+	int b = x * 2;\r\n\
+	b = x + 1;\r\n\
+	return x;\r\n\
+	tick();\r\n\
+}\r\n\
+int loops(int x)\r\n\
+{\r\n\
+	int i = 5;\r\n\
+	while(0){ i = tick(); }\r\n\
+	for(i = x; 0; i++) tick();\r\n\
+	return i;\r\n\
+}\r\n\
+int breaks(int n)\r\n\
+{\r\n\
+	int s = 0;\r\n\
+	for(int i = 0; i < n; i++)\r\n\
+	{\r\n\
+		if(i == 3)\r\n\
+			break;\r\n\
+		s += i;\r\n\
+		continue;\r\n\
+		s += 100;\r\n\
+	}\r\n\
+	return s;\r\n\
+}\r\n\
+int x = 7;\r\n\
+int r1 = unused(x), r2 = loops(x), r3 = breaks(x);\r\n\
+return r1 + r2 * 10 + r3 * 100 + counter * 1000;";
+TEST_RESULT("Unreachable statements and unused stores are removed without losing side effects", testDeadCode, "1377");
+
+const char *testStackAllocation =
+"class vec3{ double x, y, z; }\r\n\
+class Node{ Node ref next; int value; }\r\n\
+class Buffer{ int[4] data; }\r\n\
+Node ref keep;\r\n\
+double len2(double a, double b, double c)\r\n\
+{\r\n\
+	vec3 ref v = new vec3;\r\n\
+	v.x = a; v.y = b; v.z = c;\r\n\
+	return v.x * v.x + v.y * v.y + v.z * v.z;\r\n\
+}\r\n\
+int loop(int n)\r\n\
+{\r\n\
+	int s = 0;\r\n\
+	for(int i = 0; i < n; i++)\r\n\
+	{\r\n\
+		Node ref t = new Node;\r\n\
+		s += t.value;\r\n\
+		t.value = i;\r\n\
+		s += t.value;\r\n\
+	}\r\n\
+	return s;\r\n\
+}\r\n\
+int escapes(int n)\r\n\
+{\r\n\
+	Node ref t = new Node;\r\n\
+	t.value = n;\r\n\
+	keep = t;\r\n\
+	return t.value;\r\n\
+}\r\n\
+int arr(int n)\r\n\
+{\r\n\
+	Buffer ref b = new Buffer;\r\n\
+	b.data[n] = n;\r\n\
+	return b.data[0] + b.data[n];\r\n\
+}\r\n\
+int x = 2;\r\n\
+int r1 = int(len2(x, x, 1)), r2 = loop(5), r3 = escapes(7), r4 = arr(3);\r\n\
+return r1 + r2 * 10 + r3 * 1000 + r4 * 10000 + keep.value * 100000;";
+TEST_RESULT("Objects that don't escape the function are placed on the stack", testStackAllocation, "737109");
@@ -32,6 +32,22 @@ long a = 5, b = 0;\r\n\
 return a % b;";
 TEST_RUNTIME_FAIL("Modulus division by zero handling 2", testModZeroLong, "ERROR: integer division by zero");
 
+const char	*testDivZeroUnusedCall = 
+"// Division by zero in a pure function call with an unused result\r\n\
+int div(int a, int b){ int r = a / b; return r; }\r\n\
+int test(int x){ div(x, 0); return x; }\r\n\
+int z = 5;\r\n\
+return test(z);";
+TEST_RUNTIME_FAIL("Division by zero handling in unused pure function call", testDivZeroUnusedCall, "ERROR: integer division by zero");
+
+const char	*testBoundsUnusedCall = 
+"// Array out of bounds in a pure function call with an unused result\r\n\
+int at(int i){ int[2] arr; return arr[i]; }\r\n\
+int test(int x){ at(x); return x; }\r\n\
+int z = 5;\r\n\
+return test(z);";
+TEST_RUNTIME_FAIL("Array out of bounds error check in unused pure function call", testBoundsUnusedCall, "ERROR: array index out of bounds");
+
 const char	*testFuncNoReturn = 
 "// Function with no return handling\r\n\
 int test(){ if(0) return 2; } // temporary\r\n\
@@ -67,6 +83,42 @@ x[2] = x2;\r\n\
 int[][] xr = x;\r\n\
 return xr[1][3];";
 TEST_RUNTIME_FAIL("Array out of bounds error check 3", testBounds3, "ERROR: array index out of bounds");
+
+const char	*testBoundsForEachMerged = 
+"// Array out of bound check in for each with multiple iterators\r\n\
+int[] arr = { 1, 2, 3 };\r\n\
+coroutine int gen(){ yield 1; arr = new int[1]; yield 2; yield 3; }\r\n\
+int sum = 0;\r\n\
+for(i in arr, j in gen)\r\n\
+	sum += i;\r\n\
+return sum;";
+TEST_RUNTIME_FAIL("Array out of bounds error check in for each with multiple iterators", testBoundsForEachMerged, "ERROR: array index out of bounds");
+
+const char	*testBoundsCountedLoop1 = 
+"// Array out of bound check in counted loop that changes the counter\r\n\
+int sum(int[] arr){ int s = 0; for(int i = 0; i < arr.size; i++){ s += arr[i]; i++; s += arr[i]; } return s; }\r\n\
+return sum({ 1, 2, 3 });";
+TEST_RUNTIME_FAIL("Array out of bounds error check in counted loop 1", testBoundsCountedLoop1, "ERROR: array index out of bounds");
+
+const char	*testBoundsCountedLoop2 = 
+"// Array out of bound check in counted loop over a size of a different array\r\n\
+class Pair{ int[] a; int[] b; }\r\n\
+int sum(Pair ref p){ int s = 0; for(int i = 0; i < p.a.size; i++) s += p.b[i]; return s; }\r\n\
+Pair p; p.a = { 1, 2, 3 }; p.b = { 4, 5 };\r\n\
+return sum(p);";
+TEST_RUNTIME_FAIL("Array out of bounds error check in counted loop 2", testBoundsCountedLoop2, "ERROR: array index out of bounds");
+
+const char	*testBoundsCountedLoop3 = 
+"// Array out of bound check in counted loop with a negative start\r\n\
+int sum(int[] arr){ int s = 0; for(int i = -1; i < arr.size; i++) s += arr[i]; return s; }\r\n\
+return sum({ 1, 2, 3 });";
+TEST_RUNTIME_FAIL("Array out of bounds error check in counted loop 3", testBoundsCountedLoop3, "ERROR: array index out of bounds");
+
+const char	*testBoundsCountedLoop4 = 
+"// Array out of bound check in counted loop over a larger fixed-size array\r\n\
+int sum(){ int[2] arr; int s = 0; for(int i = 0; i < 3; i++) s += arr[i]; return s; }\r\n\
+return sum();";
+TEST_RUNTIME_FAIL("Array out of bounds error check in counted loop 4", testBoundsCountedLoop4, "ERROR: array index out of bounds");
 
 const char	*testInvalidFuncPtr = 
 "int ref(int) a;\r\n\
@@ -20,6 +20,8 @@
 
 #include "../NULLC/includes/pugi.h"
 
+#include "../NULLC/Lexer.h"
+
 double speedTestTimeThreshold = 5000;	// how long, in ms, to run a speed test
 #define RUN_GC_TESTS
 
@@ -92,6 +94,55 @@ void	SpeedTestText(const char* name, const char* text)
 	printf("Average time: %f Speed: %.3f Mb/sec\n\n", linkTime / double(runs), strlen(text) * (1000.0 / (linkTime / double(runs))) / 1024.0 / 1024.0);
 }
 
+// Measures VM execution speed of a program, the name of the VM instruction dispatch mode is reported with the results
+// To compare dispatch modes, build with "make config=release" and "make config=release dispatch=switch" and run "./TestRun speed tests" for both
+void	SpeedTestRun(const char* name, const char* text, const char* expected)
+{
+#ifdef NULLC_VM_COMPUTED_GOTO
+	const char *dispatch = "computed goto";
+#else
+	const char *dispatch = "switch";
+#endif
+
+	nullcSetExecutor(NULLC_VM);
+
+	if(!nullcCompile(text))
+	{
+		printf("Compilation failed: %s\r\n", nullcGetLastError());
+		return;
+	}
+
+	char *bytecode = NULL;
+	nullcGetBytecode(&bytecode);
+
+	unsigned int runs = 0;
+	double runTime = 0.0;
+	while(runTime < speedTestTimeThreshold)
+	{
+		nullcClean();
+		if(!nullcLinkCode(bytecode))
+		{
+			printf("Link failed: %s\r\n", nullcGetLastError());
+			break;
+		}
+
+		double time = myGetPreciseTime();
+		nullres good = nullcRun();
+		runTime += myGetPreciseTime() - time;
+		runs++;
+
+		if(!good || strcmp(nullcGetResult(), expected) != 0)
+		{
+			printf("Execution failed: %s\r\n", good ? nullcGetResult() : nullcGetLastError());
+			break;
+		}
+	}
+	delete[] bytecode;
+
+	printf("VM dispatch (%s) speed test (%s) managed to run %d times in %f ms\n", dispatch, name, runs, runTime);
+	printf("Average time: %f\n\n", runTime / double(runs));
+}
+
 void	SpeedTestFile(const char* file)
 {
 	char *blob = new char[1024 * 1024];
@@ -508,6 +559,40 @@ return 0;";
 		printf("%s finished in %f (single run is %f)\r\n", t == NULLC_VM ? "VM" : "X86", myGetPreciseTime() - tStart, (myGetPreciseTime() - tStart) / 10000.0);
 	}
 
+	// Test VM instruction dispatch on call, loop and array heavy code
+	speedTestTimeThreshold = 2000;
+
+	SpeedTestRun("progressbar.nc inlined", testCompileSpeed2, "0");
+
+	const char	*testDispatchFib =
+"int fib(int n){ return n < 2 ? n : fib(n - 1) + fib(n - 2); }\r\n\
+int n = 24;\r\n\
+return fib(n);";
+	SpeedTestRun("fibonacci", testDispatchFib, "46368");
+
+	const char	*testDispatchSieve =
+"bool[] composite = new bool[200000];\r\n\
+int count = 0;\r\n\
+for(int i = 2; i < composite.size; i++)\r\n\
+{\r\n\
+	if(composite[i])\r\n\
+		continue;\r\n\
+	count++;\r\n\
+	for(int k = i * 2; k < composite.size; k += i)\r\n\
+		composite[k] = true;\r\n\
+}\r\n\
+return count;";
+	SpeedTestRun("sieve", testDispatchSieve, "17984");
+
+	const char	*testDispatchSeries =
+"double sum = 0.0;\r\n\
+for(int i = 1; i < 300000; i++)\r\n\
+	sum += (i % 2 == 0 ? -1.0 : 1.0) / (2.0 * i - 1.0);\r\n\
+return int(sum * 100000.0);";
+	SpeedTestRun("series", testDispatchSeries, "78539");
+
+	speedTestTimeThreshold = 5000;
+
 #if defined(_MSC_VER)
 const char	*testCompileSpeed3 =
 "import img.canvas;\r\n\
@@ -838,6 +923,33 @@ auto arr = \r\n\
 
 	delete[] tmp;
 
+	// Test how function lookup scales in a module with a large number of functions
+	char *manyFunctions = new char[4 * 1024 * 1024];
+	char *pos = manyFunctions;
+	for(unsigned i = 0; i < 50000; i++)
+		pos += sprintf(pos, "int f%u(int x){ return x + %u; }\r\n", i, i);
+	pos += sprintf(pos, "int s = 0;\r\n");
+	for(unsigned i = 0; i < 50000; i += 7)
+		pos += sprintf(pos, "s += f%u(s);\r\n", i);
+	sprintf(pos, "return s;");
+	SpeedTestText("50000 functions", manyFunctions);
+
+	// Test lexer alone on the same source
+	Lexer lexer;
+	unsigned int lexRuns = 0;
+	double lexTime = myGetPreciseTime();
+	while(myGetPreciseTime() - lexTime < speedTestTimeThreshold)
+	{
+		lexer.Clear(0);
+		lexer.Lexify(manyFunctions);
+		lexRuns++;
+	}
+	lexTime = myGetPreciseTime() - lexTime;
+	printf("Lexer speed test (50000 functions) managed to run %d times in %f ms\n", lexRuns, lexTime);
+	printf("Average time: %f Speed: %.3f Mb/sec\n\n", lexTime / double(lexRuns), strlen(manyFunctions) * (1000.0 / (lexTime / double(lexRuns))) / 1024.0 / 1024.0);
+
+	delete[] manyFunctions;
+
 #endif
 
 #ifdef SPEED_TEST_EXTRA